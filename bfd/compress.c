@@ -23,9 +23,17 @@
 #include "bfd.h"
 #include "libbfd.h"
 #include "safe-ctype.h"
+#ifdef HAVE_MMAP
+#include <sys/mman.h>
+#endif
 
 #define MAX_COMPRESSION_HEADER_SIZE 24
 
+/* Compressed contents at least this large are mapped from the file
+   rather than read, when possible.  Below this, a read is cheaper
+   than setting up and tearing down a mapping.  */
+#define MIN_MAPPED_COMPRESSED_SIZE (64 * 1024)
+
 static bfd_boolean
 decompress_contents (bfd_byte *compressed_buffer,
 		     bfd_size_type compressed_size,
@@ -64,6 +72,98 @@ decompress_contents (bfd_byte *compressed_buffer,
   return rc == Z_OK && strm.avail_out == 0;
 }
 
+/* Fetch the raw, still compressed, contents of section SEC of ABFD.
+   Large contents are mapped straight from the file when possible,
+   which saves reading them into a buffer of their own only to inflate
+   them and throw them away.  *MAP_ADDR and *MAP_LEN are set to the
+   mapping to release with free_compressed_contents, or to NULL and 0
+   if the contents were read into a malloc'd buffer.  Return NULL on
+   failure.  */
+
+static bfd_byte *
+get_compressed_contents (bfd *abfd, sec_ptr sec,
+			 void **map_addr, bfd_size_type *map_len)
+{
+  bfd_byte *compressed_buffer;
+  bfd_size_type save_size;
+  bfd_size_type save_rawsize;
+  bfd_boolean ret;
+
+  *map_addr = NULL;
+  *map_len = 0;
+
+#ifdef HAVE_MMAP
+  /* Only map contents that are known to sit unchanged at the
+     section's file position, and that lie within the file.  */
+  if (sec->compressed_size >= MIN_MAPPED_COMPRESSED_SIZE
+      && (abfd->flags & BFD_IN_MEMORY) == 0
+      && (sec->flags & (SEC_IN_MEMORY | SEC_HAS_CONTENTS)) == SEC_HAS_CONTENTS
+      && (abfd->xvec->_bfd_get_section_contents
+	  == _bfd_generic_get_section_contents)
+      && sec->filepos >= 0)
+    {
+      ufile_ptr file_size = bfd_get_file_size (abfd);
+
+      if ((ufile_ptr) sec->filepos <= file_size
+	  && sec->compressed_size <= file_size - (ufile_ptr) sec->filepos)
+	{
+	  compressed_buffer = (bfd_byte *) bfd_mmap (abfd, NULL,
+						     sec->compressed_size,
+						     PROT_READ, MAP_PRIVATE,
+						     sec->filepos,
+						     map_addr, map_len);
+	  if (compressed_buffer != (bfd_byte *) -1)
+	    return compressed_buffer;
+
+	  /* Fall back to reading the contents.  */
+	  *map_addr = NULL;
+	  *map_len = 0;
+	}
+    }
+#endif
+
+  compressed_buffer = (bfd_byte *) bfd_malloc (sec->compressed_size);
+  if (compressed_buffer == NULL)
+    return NULL;
+  save_rawsize = sec->rawsize;
+  save_size = sec->size;
+  /* Clear rawsize, set size to compressed size and set compress_status
+     to COMPRESS_SECTION_NONE.  If the compressed size is bigger than
+     the uncompressed size, bfd_get_section_contents will fail.  */
+  sec->rawsize = 0;
+  sec->size = sec->compressed_size;
+  sec->compress_status = COMPRESS_SECTION_NONE;
+  ret = bfd_get_section_contents (abfd, sec, compressed_buffer,
+				  0, sec->compressed_size);
+  /* Restore rawsize and size.  */
+  sec->rawsize = save_rawsize;
+  sec->size = save_size;
+  sec->compress_status = DECOMPRESS_SECTION_SIZED;
+  if (!ret)
+    {
+      free (compressed_buffer);
+      return NULL;
+    }
+  return compressed_buffer;
+}
+
+/* Release COMPRESSED_BUFFER, as returned by get_compressed_contents
+   together with MAP_ADDR and MAP_LEN.  */
+
+static void
+free_compressed_contents (bfd_byte *compressed_buffer,
+			  void *map_addr, bfd_size_type map_len)
+{
+#ifdef HAVE_MMAP
+  if (map_addr != NULL)
+    {
+      munmap (map_addr, map_len);
+      return;
+    }
+#endif
+  free (compressed_buffer);
+}
+
 /* Compress data of the size specified in @var{uncompressed_size}
    and pointed to by @var{uncompressed_buffer} using zlib and store
    as the contents field.  This function assumes the contents
@@ -229,10 +329,9 @@ bfd_get_full_section_contents (bfd *abfd, sec_ptr sec, bfd_byte **ptr)
 {
   bfd_size_type sz;
   bfd_byte *p = *ptr;
-  bfd_boolean ret;
-  bfd_size_type save_size;
-  bfd_size_type save_rawsize;
   bfd_byte *compressed_buffer;
+  void *map_addr;
+  bfd_size_type map_len;
   unsigned int compression_header_size;
 
   if (abfd->direction != write_direction && sec->rawsize != 0)
@@ -273,26 +372,11 @@ bfd_get_full_section_contents (bfd *abfd, sec_ptr sec, bfd_byte **ptr)
       return TRUE;
 
     case DECOMPRESS_SECTION_SIZED:
-      /* Read in the full compressed section contents.  */
-      compressed_buffer = (bfd_byte *) bfd_malloc (sec->compressed_size);
+      /* Fetch the full compressed section contents.  */
+      compressed_buffer = get_compressed_contents (abfd, sec,
+						   &map_addr, &map_len);
       if (compressed_buffer == NULL)
 	return FALSE;
-      save_rawsize = sec->rawsize;
-      save_size = sec->size;
-      /* Clear rawsize, set size to compressed size and set compress_status
-	 to COMPRESS_SECTION_NONE.  If the compressed size is bigger than
-	 the uncompressed size, bfd_get_section_contents will fail.  */
-      sec->rawsize = 0;
-      sec->size = sec->compressed_size;
-      sec->compress_status = COMPRESS_SECTION_NONE;
-      ret = bfd_get_section_contents (abfd, sec, compressed_buffer,
-				      0, sec->compressed_size);
-      /* Restore rawsize and size.  */
-      sec->rawsize = save_rawsize;
-      sec->size = save_size;
-      sec->compress_status = DECOMPRESS_SECTION_SIZED;
-      if (!ret)
-	goto fail_compressed;
 
       if (p == NULL)
 	p = (bfd_byte *) bfd_malloc (sz);
@@ -311,11 +395,11 @@ bfd_get_full_section_contents (bfd *abfd, sec_ptr sec, bfd_byte **ptr)
 	  if (p != *ptr)
 	    free (p);
 	fail_compressed:
-	  free (compressed_buffer);
+	  free_compressed_contents (compressed_buffer, map_addr, map_len);
 	  return FALSE;
 	}
 
-      free (compressed_buffer);
+      free_compressed_contents (compressed_buffer, map_addr, map_len);
       *ptr = p;
       return TRUE;
 
@@ -21,6 +21,10 @@
 #include "splay-tree.h"
 #include "gdb_obstack.h"
 #include "addrmap.h"
+#include "common/selftest.h"
+#include <algorithm>
+#include <numeric>
+#include <queue>
 
 
 /* The "abstract class".  */
@@ -421,13 +425,34 @@ splay_foreach_copy (splay_tree_node n, void *closure)
 }
 
 
+/* Allocate in OBSTACK a fixed address map with room for
+   NUM_TRANSITIONS transitions.  Only its first transition, the one at
+   address zero, is filled in; it maps to NULL.  */
+
+static struct addrmap_fixed *
+allocate_fixed (struct obstack *obstack, size_t num_transitions)
+{
+  struct addrmap_fixed *fixed;
+  size_t alloc_len;
+
+  alloc_len = sizeof (*fixed)
+	      + (num_transitions * sizeof (fixed->transitions[0]));
+  fixed = (struct addrmap_fixed *) obstack_alloc (obstack, alloc_len);
+  fixed->addrmap.funcs = &addrmap_fixed_funcs;
+  fixed->num_transitions = 1;
+  fixed->transitions[0].addr = 0;
+  fixed->transitions[0].value = NULL;
+
+  return fixed;
+}
+
+
 static struct addrmap *
 addrmap_mutable_create_fixed (struct addrmap *self, struct obstack *obstack)
 {
   struct addrmap_mutable *mutable_obj = (struct addrmap_mutable *) self;
   struct addrmap_fixed *fixed;
   size_t num_transitions;
-  size_t alloc_len;
 
   /* Count the number of transitions in the tree.  */
   num_transitions = 0;
@@ -437,13 +462,7 @@ addrmap_mutable_create_fixed (struct addrmap *self, struct obstack *obstack)
      maps have, but mutable maps do not.)  */
   num_transitions++;
 
-  alloc_len = sizeof (*fixed)
-	      + (num_transitions * sizeof (fixed->transitions[0]));
-  fixed = (struct addrmap_fixed *) obstack_alloc (obstack, alloc_len);
-  fixed->addrmap.funcs = &addrmap_fixed_funcs;
-  fixed->num_transitions = 1;
-  fixed->transitions[0].addr = 0;
-  fixed->transitions[0].value = NULL;
+  fixed = allocate_fixed (obstack, num_transitions);
 
   /* Copy all entries from the splay tree to the array, in order 
      of increasing address.  */
@@ -588,6 +607,214 @@ addrmap_create_mutable (struct obstack *obstack)
   return (struct addrmap *) map;
 }
 
+/* Address map builders.  */
+
+void
+addrmap_builder::set_empty (CORE_ADDR start, CORE_ADDR end_inclusive,
+			    void *obj)
+{
+  /* See addrmap_mutable_set_empty.  */
+  gdb_assert (obj);
+
+  /* An inverted range maps nothing, as with a mutable map.  */
+  if (start > end_inclusive)
+    return;
+
+  m_ranges.push_back ({start, end_inclusive, obj});
+}
+
+struct addrmap *
+addrmap_builder::create_fixed (struct obstack *obstack) const
+{
+  size_t n = m_ranges.size ();
+
+  /* Sweep the address space in order, visiting each address where a
+     range starts, or where one has just ended.  At each of those, the
+     address is mapped by the earliest added range that covers it, so
+     we keep the indices of the covering ranges in a min-heap.  Ranges
+     that have ended are only dropped once they reach its top.  */
+  std::vector<size_t> by_start (n), by_end (n);
+  std::iota (by_start.begin (), by_start.end (), 0);
+  std::iota (by_end.begin (), by_end.end (), 0);
+  std::sort (by_start.begin (), by_start.end (),
+	     [this] (size_t a, size_t b)
+    {
+      return m_ranges[a].start < m_ranges[b].start;
+    });
+  std::sort (by_end.begin (), by_end.end (),
+	     [this] (size_t a, size_t b)
+    {
+      return m_ranges[a].end_inclusive < m_ranges[b].end_inclusive;
+    });
+
+  std::priority_queue<size_t, std::vector<size_t>, std::greater<size_t>>
+    covering;
+  std::vector<bool> ended (n);
+  std::vector<addrmap_transition> transitions;
+
+  /* Fixed maps always have a transition at zero.  */
+  transitions.push_back ({0, NULL});
+
+  size_t next_start = 0, next_end = 0;
+  while (true)
+    {
+      /* A range that reaches the top of the address space never ends.  */
+      while (next_end < n
+	     && m_ranges[by_end[next_end]].end_inclusive == CORE_ADDR_MAX)
+	++next_end;
+
+      bool have_start = next_start < n;
+      bool have_end = next_end < n;
+      if (!have_start && !have_end)
+	break;
+
+      CORE_ADDR addr;
+      if (!have_end)
+	addr = m_ranges[by_start[next_start]].start;
+      else if (!have_start)
+	addr = m_ranges[by_end[next_end]].end_inclusive + 1;
+      else
+	addr = std::min (m_ranges[by_start[next_start]].start,
+			 m_ranges[by_end[next_end]].end_inclusive + 1);
+
+      while (next_start < n && m_ranges[by_start[next_start]].start == addr)
+	covering.push (by_start[next_start++]);
+      while (next_end < n
+	     && m_ranges[by_end[next_end]].end_inclusive != CORE_ADDR_MAX
+	     && m_ranges[by_end[next_end]].end_inclusive + 1 == addr)
+	ended[by_end[next_end++]] = true;
+      while (!covering.empty () && ended[covering.top ()])
+	covering.pop ();
+
+      void *value = covering.empty () ? NULL : m_ranges[covering.top ()].obj;
+      if (transitions.back ().addr == addr)
+	{
+	  /* Only possible for the transition at zero.  */
+	  transitions.back ().value = value;
+	}
+      else if (transitions.back ().value != value)
+	transitions.push_back ({addr, value});
+    }
+
+  struct addrmap_fixed *fixed = allocate_fixed (obstack, transitions.size ());
+  std::copy (transitions.begin (), transitions.end (), fixed->transitions);
+  fixed->num_transitions = transitions.size ();
+
+  return (struct addrmap *) fixed;
+}
+
+#if GDB_SELF_TEST
+namespace selftests {
+namespace addrmap_builder_tests {
+
+/* A function to pass to addrmap_foreach, collecting the transitions
+   of a map.  */
+
+static int
+collect_transitions (void *data, CORE_ADDR start_addr, void *obj)
+{
+  auto *transitions
+    = (std::vector<std::pair<CORE_ADDR, void *>> *) data;
+
+  transitions->emplace_back (start_addr, obj);
+  return 0;
+}
+
+/* Add the ranges in RANGES to both a mutable map and a builder, and
+   check that the fixed maps they produce agree at every range
+   boundary.  Also check that the builder did not emit any redundant
+   transitions.  */
+
+static void
+check_same_as_mutable (const std::vector<std::pair<CORE_ADDR, CORE_ADDR>>
+		       &ranges)
+{
+  auto_obstack obstack;
+  struct addrmap *mutable_map = addrmap_create_mutable (&obstack);
+  addrmap_builder builder;
+  /* Any distinct non-NULL pointers will do as values.  */
+  static char objs[64];
+  std::vector<CORE_ADDR> probes = { 0, CORE_ADDR_MAX };
+
+  for (size_t i = 0; i < ranges.size (); ++i)
+    {
+      void *obj = &objs[i % sizeof (objs)];
+      CORE_ADDR start = ranges[i].first;
+      CORE_ADDR end_inclusive = ranges[i].second;
+
+      addrmap_set_empty (mutable_map, start, end_inclusive, obj);
+      builder.set_empty (start, end_inclusive, obj);
+
+      probes.insert (probes.end (), { start - 1, start, start + 1,
+				      end_inclusive - 1, end_inclusive,
+				      end_inclusive + 1 });
+    }
+
+  struct addrmap *expected = addrmap_create_fixed (mutable_map, &obstack);
+  struct addrmap *result = builder.create_fixed (&obstack);
+
+  for (CORE_ADDR addr : probes)
+    SELF_CHECK (addrmap_find (expected, addr) == addrmap_find (result, addr));
+
+  std::vector<std::pair<CORE_ADDR, void *>> transitions;
+  addrmap_foreach (result, collect_transitions, &transitions);
+  SELF_CHECK (transitions[0].first == 0);
+  for (size_t i = 1; i < transitions.size (); ++i)
+    {
+      SELF_CHECK (transitions[i - 1].first < transitions[i].first);
+      SELF_CHECK (transitions[i - 1].second != transitions[i].second);
+    }
+}
+
+static void
+run_tests ()
+{
+  /* No ranges at all.  */
+  check_same_as_mutable ({});
+
+  /* Disjoint, adjacent, overlapping, nested and duplicate ranges.  */
+  check_same_as_mutable ({{10, 19}, {30, 39}});
+  check_same_as_mutable ({{30, 39}, {10, 19}, {20, 29}});
+  check_same_as_mutable ({{10, 29}, {20, 39}});
+  check_same_as_mutable ({{20, 39}, {10, 29}});
+  check_same_as_mutable ({{10, 49}, {20, 29}});
+  check_same_as_mutable ({{20, 29}, {10, 49}});
+  check_same_as_mutable ({{10, 19}, {10, 19}});
+
+  /* Ranges touching either end of the address space.  */
+  check_same_as_mutable ({{0, 9}, {CORE_ADDR_MAX - 9, CORE_ADDR_MAX}});
+  check_same_as_mutable ({{5, CORE_ADDR_MAX}, {0, 9}});
+  check_same_as_mutable ({{0, CORE_ADDR_MAX}});
+
+  /* An inverted range maps nothing.  */
+  check_same_as_mutable ({{10, 19}, {30, 29}});
+
+  /* Many random ranges, so that overlaps of all kinds occur.  */
+  unsigned int seed = 1;
+  for (int iter = 0; iter < 20; ++iter)
+    {
+      std::vector<std::pair<CORE_ADDR, CORE_ADDR>> ranges;
+
+      for (int i = 0; i < 100; ++i)
+	{
+	  /* A simple linear congruential generator is enough here, and
+	     keeps the test reproducible.  */
+	  seed = seed * 1103515245 + 12345;
+	  CORE_ADDR start = (seed >> 8) % 1000;
+	  seed = seed * 1103515245 + 12345;
+	  CORE_ADDR length = (seed >> 8) % 50;
+
+	  ranges.emplace_back (start, start + length);
+	}
+
+      check_same_as_mutable (ranges);
+    }
+}
+
+} /* namespace addrmap_builder_tests */
+} /* namespace selftests */
+#endif /* GDB_SELF_TEST */
+
 /* Initialization.  */
 
 void
@@ -597,4 +824,9 @@ _initialize_addrmap (void)
      store in them.  */
   gdb_assert (sizeof (splay_tree_key) >= sizeof (CORE_ADDR *));
   gdb_assert (sizeof (splay_tree_value) >= sizeof (void *));
+
+#if GDB_SELF_TEST
+  selftests::register_test ("addrmap_builder",
+			    selftests::addrmap_builder_tests::run_tests);
+#endif
 }
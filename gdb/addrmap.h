@@ -20,6 +20,8 @@
 #ifndef ADDRMAP_H
 #define ADDRMAP_H
 
+#include <vector>
+
 /* An address map is essentially a table mapping CORE_ADDRs onto GDB
    data structures, like blocks, symtabs, partial symtabs, and so on.
    An address map uses memory proportional to the number of
@@ -102,4 +104,38 @@ typedef int (*addrmap_foreach_fn) (void *data, CORE_ADDR start_addr,
    Otherwise, this function returns 0.  */
 int addrmap_foreach (struct addrmap *map, addrmap_foreach_fn fn, void *data);
 
+/* A builder for fixed address maps, for use when all the ranges are
+   known before the map is needed, as when reading an index.  Adding
+   ranges to a mutable map costs a splay tree update each, and makes
+   one obstack allocation per transition.  The builder instead just
+   records the ranges, and creates the fixed map by sorting them in a
+   single pass at the end.  */
+
+class addrmap_builder
+{
+public:
+
+  /* Map to OBJ the addresses from START to END_INCLUSIVE that no
+     range added earlier maps.  This has the same semantics as
+     addrmap_set_empty on a mutable map: where ranges overlap, the
+     range added first wins.  */
+  void set_empty (CORE_ADDR start, CORE_ADDR end_inclusive, void *obj);
+
+  /* Create a fixed address map holding all the ranges added so far.
+     Allocate it in OBSTACK.  */
+  struct addrmap *create_fixed (struct obstack *obstack) const;
+
+private:
+
+  struct range
+  {
+    CORE_ADDR start;
+    CORE_ADDR end_inclusive;
+    void *obj;
+  };
+
+  /* The ranges, in the order they were added.  */
+  std::vector<range> m_ranges;
+};
+
 #endif /* ADDRMAP_H */
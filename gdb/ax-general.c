@@ -26,6 +26,8 @@
 
 #include "value.h"
 #include "user-regs.h"
+#include "regcache.h"
+#include "target.h"
 
 static void grow_expr (struct agent_expr *x, int n);
 
@@ -599,3 +601,326 @@ ax_reqs (struct agent_expr *ax)
 
   ax->final_height = height;
 }
+
+
+/* The deepest stack ax_eval_on_host supports.  Expressions compiled
+   from source expressions rarely need more than a handful of
+   slots.  */
+#define AX_HOST_STACK_MAX 64
+
+/* See ax.h.  */
+
+bool
+ax_host_evaluable (struct agent_expr *ax)
+{
+  int i;
+
+  for (i = 0; i < ax->len; i += 1 + aop_map[ax->buf[i]].op_size)
+    {
+      if (ax->buf[i] >= aop_last)
+	return false;
+
+      switch (ax->buf[i])
+	{
+	case aop_add:
+	case aop_sub:
+	case aop_mul:
+	case aop_div_signed:
+	case aop_div_unsigned:
+	case aop_rem_signed:
+	case aop_rem_unsigned:
+	case aop_lsh:
+	case aop_rsh_signed:
+	case aop_rsh_unsigned:
+	case aop_log_not:
+	case aop_bit_and:
+	case aop_bit_or:
+	case aop_bit_xor:
+	case aop_bit_not:
+	case aop_equal:
+	case aop_less_signed:
+	case aop_less_unsigned:
+	case aop_ext:
+	case aop_zero_ext:
+	case aop_ref8:
+	case aop_ref16:
+	case aop_ref32:
+	case aop_ref64:
+	case aop_const8:
+	case aop_const16:
+	case aop_const32:
+	case aop_const64:
+	case aop_reg:
+	case aop_end:
+	case aop_dup:
+	case aop_pop:
+	case aop_swap:
+	case aop_pick:
+	case aop_rot:
+	  break;
+
+	case aop_if_goto:
+	case aop_goto:
+	  /* Only forward jumps, so that evaluation always ends.  */
+	  if (i + 3 > ax->len || read_const (ax, i + 1, 2) <= i)
+	    return false;
+	  break;
+
+	default:
+	  /* Floating point, tracing, trace state variables and
+	     printf.  */
+	  return false;
+	}
+    }
+
+  ax_reqs (ax);
+
+  return (ax->flaw == agent_flaw_none
+	  && ax->min_height >= 0
+	  && ax->max_height <= AX_HOST_STACK_MAX
+	  && ax->final_height == 1);
+}
+
+/* Return the GDB register number of remote register number
+   REMOTE_REGNUM in GDBARCH, or -1 if there is none.  */
+
+static int
+ax_regnum_from_remote (struct gdbarch *gdbarch, int remote_regnum)
+{
+  int num_regs = gdbarch_num_regs (gdbarch);
+
+  /* Remote and GDB numbers are usually the same.  */
+  if (remote_regnum < num_regs
+      && gdbarch_remote_register_number (gdbarch,
+					 remote_regnum) == remote_regnum)
+    return remote_regnum;
+
+  for (int regnum = 0; regnum < num_regs; regnum++)
+    if (gdbarch_remote_register_number (gdbarch, regnum) == remote_regnum)
+      return regnum;
+
+  return -1;
+}
+
+/* See ax.h.  */
+
+bool
+ax_eval_on_host (struct agent_expr *ax, struct regcache *regcache,
+		 ULONGEST *result)
+{
+  struct gdbarch *gdbarch = ax->gdbarch;
+  enum bfd_endian byte_order = gdbarch_byte_order (gdbarch);
+  const int value_bits = sizeof (ULONGEST) * HOST_CHAR_BIT;
+  ULONGEST stack[AX_HOST_STACK_MAX];
+  gdb_byte buf[sizeof (ULONGEST)];
+  int sp = 0;
+  int pc = 0;
+
+  /* ax_host_evaluable has checked the jumps and the stack heights, so
+     only the values and the depth of picks need checking here.  */
+  while (pc < ax->len)
+    {
+      enum agent_op op = (enum agent_op) ax->buf[pc];
+      LONGEST arg = 0;
+      ULONGEST a, b;
+
+      if (aop_map[op].op_size > 0)
+	arg = read_const (ax, pc + 1, aop_map[op].op_size);
+      pc += 1 + aop_map[op].op_size;
+
+      switch (op)
+	{
+	case aop_add:
+	  sp--;
+	  stack[sp - 1] += stack[sp];
+	  break;
+
+	case aop_sub:
+	  sp--;
+	  stack[sp - 1] -= stack[sp];
+	  break;
+
+	case aop_mul:
+	  sp--;
+	  stack[sp - 1] *= stack[sp];
+	  break;
+
+	case aop_div_signed:
+	case aop_rem_signed:
+	  sp--;
+	  a = stack[sp - 1];
+	  b = stack[sp];
+	  if (b == 0
+	      || ((LONGEST) b == -1
+		  && a == (ULONGEST) 1 << (value_bits - 1)))
+	    return false;
+	  if (op == aop_div_signed)
+	    stack[sp - 1] = (LONGEST) a / (LONGEST) b;
+	  else
+	    stack[sp - 1] = (LONGEST) a % (LONGEST) b;
+	  break;
+
+	case aop_div_unsigned:
+	case aop_rem_unsigned:
+	  sp--;
+	  a = stack[sp - 1];
+	  b = stack[sp];
+	  if (b == 0)
+	    return false;
+	  stack[sp - 1] = op == aop_div_unsigned ? a / b : a % b;
+	  break;
+
+	case aop_lsh:
+	case aop_rsh_signed:
+	case aop_rsh_unsigned:
+	  sp--;
+	  a = stack[sp - 1];
+	  b = stack[sp];
+	  if (b >= value_bits)
+	    return false;
+	  if (op == aop_lsh)
+	    stack[sp - 1] = a << b;
+	  else if (op == aop_rsh_signed)
+	    stack[sp - 1] = (LONGEST) a >> b;
+	  else
+	    stack[sp - 1] = a >> b;
+	  break;
+
+	case aop_log_not:
+	  stack[sp - 1] = !stack[sp - 1];
+	  break;
+
+	case aop_bit_and:
+	  sp--;
+	  stack[sp - 1] &= stack[sp];
+	  break;
+
+	case aop_bit_or:
+	  sp--;
+	  stack[sp - 1] |= stack[sp];
+	  break;
+
+	case aop_bit_xor:
+	  sp--;
+	  stack[sp - 1] ^= stack[sp];
+	  break;
+
+	case aop_bit_not:
+	  stack[sp - 1] = ~stack[sp - 1];
+	  break;
+
+	case aop_equal:
+	  sp--;
+	  stack[sp - 1] = stack[sp - 1] == stack[sp];
+	  break;
+
+	case aop_less_signed:
+	  sp--;
+	  stack[sp - 1] = (LONGEST) stack[sp - 1] < (LONGEST) stack[sp];
+	  break;
+
+	case aop_less_unsigned:
+	  sp--;
+	  stack[sp - 1] = stack[sp - 1] < stack[sp];
+	  break;
+
+	case aop_ext:
+	  if (arg > 0 && arg < value_bits)
+	    {
+	      ULONGEST sign = (ULONGEST) 1 << (arg - 1);
+
+	      a = stack[sp - 1] & (((ULONGEST) 1 << arg) - 1);
+	      stack[sp - 1] = (a ^ sign) - sign;
+	    }
+	  break;
+
+	case aop_zero_ext:
+	  if (arg < value_bits)
+	    stack[sp - 1] &= ((ULONGEST) 1 << arg) - 1;
+	  break;
+
+	case aop_ref8:
+	case aop_ref16:
+	case aop_ref32:
+	case aop_ref64:
+	  {
+	    int len = aop_map[op].data_size / 8;
+
+	    if (target_read_memory (stack[sp - 1], buf, len) != 0)
+	      return false;
+	    stack[sp - 1] = extract_unsigned_integer (buf, len, byte_order);
+	  }
+	  break;
+
+	case aop_if_goto:
+	  sp--;
+	  if (stack[sp] != 0)
+	    pc = arg;
+	  break;
+
+	case aop_goto:
+	  pc = arg;
+	  break;
+
+	case aop_const8:
+	case aop_const16:
+	case aop_const32:
+	case aop_const64:
+	  stack[sp++] = arg;
+	  break;
+
+	case aop_reg:
+	  {
+	    int regnum = ax_regnum_from_remote (gdbarch, arg);
+	    int len;
+
+	    if (regnum < 0)
+	      return false;
+	    len = register_size (gdbarch, regnum);
+	    if (len > (int) sizeof (buf)
+		|| regcache->raw_read (regnum, buf) != REG_VALID)
+	      return false;
+	    stack[sp++] = extract_unsigned_integer (buf, len, byte_order);
+	  }
+	  break;
+
+	case aop_end:
+	  *result = stack[sp - 1];
+	  return true;
+
+	case aop_dup:
+	  stack[sp] = stack[sp - 1];
+	  sp++;
+	  break;
+
+	case aop_pop:
+	  sp--;
+	  break;
+
+	case aop_swap:
+	  std::swap (stack[sp - 1], stack[sp - 2]);
+	  break;
+
+	case aop_pick:
+	  /* ax_reqs does not check how deep the pick reaches.  */
+	  if (arg < 0 || arg >= sp)
+	    return false;
+	  stack[sp] = stack[sp - 1 - arg];
+	  sp++;
+	  break;
+
+	case aop_rot:
+	  /* A B C => C A B.  */
+	  a = stack[sp - 1];
+	  stack[sp - 1] = stack[sp - 2];
+	  stack[sp - 2] = stack[sp - 3];
+	  stack[sp - 3] = a;
+	  break;
+
+	default:
+	  return false;
+	}
+    }
+
+  return false;
+}
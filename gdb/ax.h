@@ -267,4 +267,25 @@ extern struct aop_map aop_map[];
 
 extern void ax_reqs (struct agent_expr *ax);
 
+
+/* Evaluating expressions in GDB itself.  */
+
+/* Return true if AX can be evaluated by ax_eval_on_host: it must be
+   free of flaws, use only opcodes that neither trace nor have side
+   effects, never jump backwards, and leave exactly one value on the
+   stack.  This calls ax_reqs on AX.  */
+
+extern bool ax_host_evaluable (struct agent_expr *ax);
+
+/* Evaluate AX, which must have passed ax_host_evaluable, reading
+   registers from REGCACHE and memory from the current target.  If
+   that succeeds, store the value left on the stack in *RESULT and
+   return true.  Return false if AX could not be evaluated, for
+   instance because it read unavailable registers or memory, or would
+   divide by zero; callers should then fall back to evaluating the
+   source expression, which reports such problems properly.  */
+
+extern bool ax_eval_on_host (struct agent_expr *ax, struct regcache *regcache,
+			     ULONGEST *result);
+
 #endif /* AX_H */
@@ -541,6 +541,11 @@ static struct bp_location **bp_locations;
 
 static unsigned bp_locations_count;
 
+/* Bumped by every update_global_location_list; see
+   bp_location::global_list_generation.  Never zero.  */
+
+static unsigned int bp_locations_generation = 1;
+
 /* Maximum alignment offset between bp_target_info.PLACED_ADDRESS and
    ADDRESS for the current elements of BP_LOCATIONS which get a valid
    result from bp_location_has_shadow.  You can use it for roughly
@@ -855,6 +860,8 @@ set_breakpoint_condition (struct breakpoint *b, const char *exp,
       for (loc = b->loc; loc; loc = loc->next)
 	{
 	  loc->cond.reset ();
+	  loc->host_cond_bytecode.reset ();
+	  loc->host_cond_bytecode_valid = false;
 
 	  /* No need to free the condition agent expression
 	     bytecode (if we have one).  We will handle this
@@ -2919,6 +2926,96 @@ update_inserted_breakpoint_locations (void)
     }
 }
 
+/* Return true if one of BL's target requests is in FAILED, as
+   returned by scoped_breakpoint_batch::commit.  */
+
+static bool
+bp_location_batch_failed (const std::vector<bp_target_info *> &failed,
+			  bp_location *bl)
+{
+  return (std::binary_search (failed.begin (), failed.end (),
+			      &bl->target_info)
+	  || std::binary_search (failed.begin (), failed.end (),
+				 &bl->overlay_target_info));
+}
+
+/* Undo the change to the inserted state of the locations whose
+   request is in FAILED, sorted as by scoped_breakpoint_batch::commit.
+   The target never carried those requests out.  */
+
+static void
+revert_batch_failed_locations (const std::vector<bp_target_info *> &failed)
+{
+  struct bp_location *bl, **blp_tmp;
+
+  if (failed.empty ())
+    return;
+
+  ALL_BP_LOCATIONS (bl, blp_tmp)
+    if (bp_location_batch_failed (failed, bl))
+      bl->inserted = !bl->inserted;
+}
+
+/* Open a target breakpoint batch for the lifetime of the object, so
+   that inserting or removing many locations costs the target a single
+   round trip.  If the scope is left without calling commit, the queued
+   requests are still flushed, and the locations whose request failed
+   are marked as they were before the request, without reporting an
+   error.  */
+
+class scoped_breakpoint_batch
+{
+public:
+  scoped_breakpoint_batch ()
+  {
+    target_begin_breakpoint_batch ();
+  }
+
+  ~scoped_breakpoint_batch ()
+  {
+    if (!m_committed)
+      {
+	try
+	  {
+	    revert_batch_failed_locations (commit ());
+	  }
+	catch (const gdb_exception &e)
+	  {
+	  }
+      }
+  }
+
+  /* Flush the batch.  Returns the target info of the requests that
+     failed, sorted so that they can be looked up with
+     std::binary_search.  If the flush throws, the locations whose
+     request the target did not acknowledge are marked as they were
+     before the request, and the error is passed on.  */
+
+  std::vector<bp_target_info *> commit ()
+  {
+    std::vector<bp_target_info *> failed;
+
+    m_committed = true;
+    try
+      {
+	target_commit_breakpoint_batch (&failed);
+      }
+    catch (const gdb_exception &e)
+      {
+	std::sort (failed.begin (), failed.end ());
+	revert_batch_failed_locations (failed);
+	throw;
+      }
+    std::sort (failed.begin (), failed.end ());
+    return failed;
+  }
+
+  DISABLE_COPY_AND_ASSIGN (scoped_breakpoint_batch);
+
+private:
+  bool m_committed = false;
+};
+
 /* Used when starting or continuing the program.  */
 
 static void
@@ -2940,6 +3037,8 @@ insert_breakpoint_locations (void)
 
   scoped_restore_current_pspace_and_thread restore_pspace_thread;
 
+  scoped_breakpoint_batch batch;
+
   ALL_BP_LOCATIONS (bl, blp_tmp)
     {
       if (!should_be_inserted (bl) || (bl->inserted && !bl->needs_update))
@@ -2968,6 +3067,25 @@ insert_breakpoint_locations (void)
 	error_flag = val;
     }
 
+  /* The target accepted the batched insertions as queued.  Insert the
+     ones it then rejected again, one at a time, so that the failure is
+     reported and handled as usual.  */
+  std::vector<bp_target_info *> failed = batch.commit ();
+  if (!failed.empty ())
+    ALL_BP_LOCATIONS (bl, blp_tmp)
+      {
+	if (!bl->inserted || !bp_location_batch_failed (failed, bl))
+	  continue;
+
+	bl->inserted = 0;
+	switch_to_program_space_and_thread (bl->pspace);
+	val = insert_bp_location (bl, &tmp_error_stream, &disabled_breaks,
+				  &hw_breakpoint_error,
+				  &hw_bp_error_explained_already);
+	if (val)
+	  error_flag = val;
+      }
+
   /* If we failed to insert all locations of a watchpoint, remove
      them, as half-inserted watchpoint is of limited use.  */
   ALL_BREAKPOINTS (bpt)  
@@ -3028,11 +3146,28 @@ remove_breakpoints (void)
   struct bp_location *bl, **blp_tmp;
   int val = 0;
 
+  scoped_breakpoint_batch batch;
+
   ALL_BP_LOCATIONS (bl, blp_tmp)
   {
     if (bl->inserted && !is_tracepoint (bl->owner))
       val |= remove_breakpoint (bl);
   }
+
+  /* Remove the locations whose batched removal failed again, one at a
+     time, so that the failure is handled as usual.  */
+  std::vector<bp_target_info *> failed = batch.commit ();
+  if (!failed.empty ())
+    ALL_BP_LOCATIONS (bl, blp_tmp)
+      {
+	if (bl->inserted || is_tracepoint (bl->owner)
+	    || !bp_location_batch_failed (failed, bl))
+	  continue;
+
+	bl->inserted = 1;
+	val |= remove_breakpoint (bl);
+      }
+
   return val;
 }
 
@@ -4687,6 +4822,86 @@ breakpoint_cond_eval (expression *exp)
   return res;
 }
 
+/* Whether breakpoint conditions are compiled to agent expression
+   bytecode for GDB to evaluate; see breakpoint_cond_eval_bytecode.  */
+
+static int breakpoint_condition_bytecode = 1;
+
+/* The number of breakpoint condition evaluations done by running
+   compiled bytecode, for "maint info breakpoint-condition-bytecode".  */
+
+static ULONGEST breakpoint_condition_bytecode_evals;
+
+static void
+show_breakpoint_condition_bytecode (struct ui_file *file, int from_tty,
+				    struct cmd_list_element *c,
+				    const char *value)
+{
+  fprintf_filtered (file, _("Compiling breakpoint conditions to "
+			    "bytecode is %s.\n"), value);
+}
+
+/* Try to evaluate the condition of breakpoint location BL, in the
+   current frame, by running its compiled bytecode instead of the
+   expression tree.  This avoids allocating values on every hit.  The
+   bytecode is compiled the first time this is called for BL.  Return
+   true and store the condition's truth value in *RESULT if that
+   worked.  Return false if the condition has to be evaluated the
+   usual way: because it uses something the bytecode cannot express,
+   such as function calls or floating point, or because evaluating the
+   bytecode failed, for instance on unreadable memory.  */
+
+static bool
+breakpoint_cond_eval_bytecode (struct bp_location *bl, bool *result)
+{
+  if (!breakpoint_condition_bytecode)
+    return false;
+
+  /* The bytecode reads registers from the innermost frame.  */
+  if (frame_relative_level (get_selected_frame (NULL)) != 0)
+    return false;
+
+  if (!bl->host_cond_bytecode_valid)
+    {
+      bl->host_cond_bytecode_valid = true;
+      try
+	{
+	  agent_expr_up aexpr = gen_eval_for_expr (bl->address,
+						   bl->cond.get ());
+
+	  if (ax_host_evaluable (aexpr.get ()))
+	    bl->host_cond_bytecode = std::move (aexpr);
+	}
+      catch (const gdb_exception_error &ex)
+	{
+	  /* Not expressible as bytecode.  */
+	}
+    }
+
+  if (bl->host_cond_bytecode == NULL)
+    return false;
+
+  ULONGEST value;
+
+  if (!ax_eval_on_host (bl->host_cond_bytecode.get (),
+			get_current_regcache (), &value))
+    return false;
+
+  *result = value != 0;
+  breakpoint_condition_bytecode_evals++;
+  return true;
+}
+
+/* Implement the "maint info breakpoint-condition-bytecode" command.  */
+
+static void
+maintenance_info_breakpoint_condition_bytecode (const char *args,
+						int from_tty)
+{
+  printf_filtered (_("Breakpoint conditions evaluated from bytecode: %s\n"),
+		   pulongest (breakpoint_condition_bytecode_evals));
+}
+
 /* Allocate a new bpstat.  Link it to the FIFO list by BS_LINK_POINTER.  */
 
 bpstats::bpstats (struct bp_location *bl, bpstat **bs_link_pointer)
@@ -5150,7 +5365,7 @@ bpstat_check_watchpoint (bpstat bs)
 static void
 bpstat_check_breakpoint_conditions (bpstat bs, thread_info *thread)
 {
-  const struct bp_location *bl;
+  struct bp_location *bl;
   struct breakpoint *b;
   /* Assume stop.  */
   bool condition_result = true;
@@ -5251,7 +5466,9 @@ bpstat_check_breakpoint_conditions (bpstat bs, thread_info *thread)
 	{
 	  try
 	    {
-	      condition_result = breakpoint_cond_eval (cond);
+	      if (w != NULL
+		  || !breakpoint_cond_eval_bytecode (bl, &condition_result))
+		condition_result = breakpoint_cond_eval (cond);
 	    }
 	  catch (const gdb_exception &ex)
 	    {
@@ -11519,6 +11736,15 @@ bp_locations_compare (const void *ap, const void *bp)
   return (a > b) - (a < b);
 }
 
+/* A less-than function for sorting locations the way
+   bp_locations_compare does.  */
+
+static bool
+bp_location_is_less_than (const bp_location *a, const bp_location *b)
+{
+  return bp_locations_compare (&a, &b) < 0;
+}
+
 /* Set bp_locations_placed_address_before_address_max and
    bp_locations_shadow_len_after_address_max according to the current
    content of the bp_locations array.  */
@@ -11722,17 +11948,45 @@ update_global_location_list (enum ugll_insert_mode insert_mode)
   bp_locations = NULL;
   bp_locations_count = 0;
 
+  /* Rather than sorting all the locations again, which is what costs
+     most here when there are many of them, keep the former array's
+     order for the locations that are still present, sort just the new
+     ones, and merge the two.  The locations that were in the former
+     array are those of the previous generation.  */
+  unsigned int previous_generation = bp_locations_generation;
+  if (++bp_locations_generation == 0)
+    bp_locations_generation = 1;
+
+  std::vector<bp_location *> added;
   ALL_BREAKPOINTS (b)
     for (loc = b->loc; loc; loc = loc->next)
-      bp_locations_count++;
+      {
+	if (loc->global_list_generation != previous_generation)
+	  added.push_back (loc);
+	loc->global_list_generation = bp_locations_generation;
+	bp_locations_count++;
+      }
 
   bp_locations = XNEWVEC (struct bp_location *, bp_locations_count);
   locp = bp_locations;
-  ALL_BREAKPOINTS (b)
-    for (loc = b->loc; loc; loc = loc->next)
-      *locp++ = loc;
-  qsort (bp_locations, bp_locations_count, sizeof (*bp_locations),
-	 bp_locations_compare);
+  for (old_locp = old_locations.get ();
+       old_locp < old_locations.get () + old_locations_count;
+       old_locp++)
+    if ((*old_locp)->global_list_generation == bp_locations_generation)
+      *locp++ = *old_locp;
+  struct bp_location **added_locp = locp;
+  std::sort (added.begin (), added.end (), bp_location_is_less_than);
+  locp = std::copy (added.begin (), added.end (), locp);
+  gdb_assert (locp == bp_locations + bp_locations_count);
+
+  /* The former order no longer holds if any of the fields locations
+     are sorted by changed meanwhile, and std::inplace_merge needs
+     both runs sorted.  */
+  if (std::is_sorted (bp_locations, added_locp, bp_location_is_less_than))
+    std::inplace_merge (bp_locations, added_locp, locp,
+			bp_location_is_less_than);
+  else
+    std::sort (bp_locations, locp, bp_location_is_less_than);
 
   bp_locations_target_extensions_update ();
 
@@ -15913,6 +16167,24 @@ when execution stops."),
 				&breakpoint_set_cmdlist,
 				&breakpoint_show_cmdlist);
 
+  add_setshow_boolean_cmd ("breakpoint-condition-bytecode", class_maintenance,
+			   &breakpoint_condition_bytecode, _("\
+Set whether GDB compiles breakpoint conditions to bytecode."), _("\
+Show whether GDB compiles breakpoint conditions to bytecode."), _("\
+When enabled, GDB evaluates the condition of a breakpoint that it\n\
+evaluates itself by running the condition compiled to agent expression\n\
+bytecode, where the condition allows that, instead of interpreting\n\
+the condition's expression."),
+			   NULL,
+			   &show_breakpoint_condition_bytecode,
+			   &maintenance_set_cmdlist,
+			   &maintenance_show_cmdlist);
+
+  add_cmd ("breakpoint-condition-bytecode", class_maintenance,
+	   maintenance_info_breakpoint_condition_bytecode, _("\
+Print how many breakpoint conditions GDB evaluated from bytecode."),
+	   &maintenanceinfolist);
+
   add_setshow_enum_cmd ("condition-evaluation", class_breakpoint,
 			condition_evaluation_enums,
 			&condition_evaluation_mode_1, _("\
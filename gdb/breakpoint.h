@@ -342,6 +342,15 @@ public:
      condition evaluation.  */
   agent_expr_up cond_bytecode;
 
+  /* COND compiled to agent expression bytecode that GDB evaluates
+     itself when the location is hit, instead of evaluating COND.
+     NULL if COND could not be compiled to such bytecode.  This is
+     only meaningful if HOST_COND_BYTECODE_VALID is set; both are
+     computed the first time the condition is evaluated, and reset
+     when the condition changes.  */
+  agent_expr_up host_cond_bytecode;
+  bool host_cond_bytecode_valid = false;
+
   /* Signals that the condition has changed since the last time
      we updated the global location list.  This means the condition
      needs to be sent to the target again.  This is used together
@@ -463,6 +472,12 @@ public:
      it becomes 0 this location is retired.  */
   int events_till_retirement = 0;
 
+  /* The value of the generation counter of the global location array
+     the last time update_global_location_list put this location in
+     that array, or zero if it never did.  This lets it tell the
+     locations that are already in the sorted array from new ones.  */
+  unsigned int global_list_generation = 0;
+
   /* Line number which was used to place this location.
 
      Breakpoint placed into a comment keeps it's user specified line number
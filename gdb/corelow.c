@@ -43,6 +43,7 @@
 #include "gdb_bfd.h"
 #include "completer.h"
 #include "common/filestuff.h"
+#include <algorithm>
 
 #ifndef O_LARGEFILE
 #define O_LARGEFILE 0
@@ -112,6 +113,10 @@ public:
 				  const char *human_name,
 				  bool required);
 
+private:
+  enum target_xfer_status read_memory (gdb_byte *readbuf, ULONGEST memaddr,
+				       ULONGEST len, ULONGEST *xfered_len);
+
 private: /* per-core data */
 
   /* The core's section table.  Note that these target sections are
@@ -122,6 +127,12 @@ private: /* per-core data */
      targets.  */
   target_section_table m_core_section_table {};
 
+  /* The non-empty sections of M_CORE_SECTION_TABLE, sorted by
+     address, so that memory reads can find their section with a
+     binary search instead of walking the table.  Core files of large
+     processes have thousands of load segments.  */
+  std::vector<const target_section *> m_core_memory_index;
+
   /* The core_fns for a core file handler that is prepared to read the
      core file currently open on core_bfd.  */
   core_fns *m_core_vec = NULL;
@@ -144,6 +155,18 @@ core_target::core_target ()
 			   &m_core_section_table.sections_end))
     error (_("\"%s\": Can't find sections: %s"),
 	   bfd_get_filename (core_bfd), bfd_errmsg (bfd_get_error ()));
+
+  for (const target_section *p = m_core_section_table.sections;
+       p < m_core_section_table.sections_end;
+       p++)
+    if (p->endaddr > p->addr)
+      m_core_memory_index.push_back (p);
+
+  std::stable_sort (m_core_memory_index.begin (), m_core_memory_index.end (),
+		    [] (const target_section *a, const target_section *b)
+		    {
+		      return a->addr < b->addr;
+		    });
 }
 
 core_target::~core_target ()
@@ -737,6 +760,63 @@ add_to_spuid_list (bfd *abfd, asection *asect, void *list_p)
   list->pos += 4;
 }
 
+/* Read up to LEN bytes of the core's memory at MEMADDR into READBUF,
+   stopping at the end of the section that holds MEMADDR.  The
+   section is found in M_CORE_MEMORY_INDEX, and its contents are
+   copied straight from a mapping of the core file when possible.  */
+
+enum target_xfer_status
+core_target::read_memory (gdb_byte *readbuf, ULONGEST memaddr,
+			  ULONGEST len, ULONGEST *xfered_len)
+{
+  /* Find the last section that starts at or before MEMADDR.  */
+  auto it = std::upper_bound (m_core_memory_index.begin (),
+			      m_core_memory_index.end (), memaddr,
+			      [] (ULONGEST addr, const target_section *p)
+			      {
+				return addr < p->addr;
+			      });
+  if (it == m_core_memory_index.begin ())
+    return TARGET_XFER_EOF;
+
+  const target_section *p = *(it - 1);
+  if (memaddr >= p->endaddr)
+    return TARGET_XFER_EOF;
+
+  struct bfd_section *asect = p->the_bfd_section;
+  ULONGEST sect_offset = memaddr - p->addr;
+  len = std::min (len, p->endaddr - memaddr);
+
+  /* Sections without contents, such as the part of a segment past its
+     file size, read as zeros.  */
+  if ((bfd_get_section_flags (core_bfd, asect) & SEC_HAS_CONTENTS) == 0)
+    {
+      memset (readbuf, 0, len);
+      *xfered_len = len;
+      return TARGET_XFER_OK;
+    }
+
+  /* Core files may be truncated, so check the mapping covers the
+     whole read; otherwise let BFD fail it.  */
+  bfd_size_type file_size;
+  const gdb_byte *contents = gdb_bfd_map_file (core_bfd, &file_size);
+  if (contents != NULL
+      && asect->filepos >= 0
+      && asect->filepos <= file_size
+      && sect_offset + len <= file_size - asect->filepos)
+    {
+      memcpy (readbuf, contents + asect->filepos + sect_offset, len);
+      *xfered_len = len;
+      return TARGET_XFER_OK;
+    }
+
+  if (!bfd_get_section_contents (core_bfd, asect, readbuf, sect_offset, len))
+    return TARGET_XFER_EOF;
+
+  *xfered_len = len;
+  return TARGET_XFER_OK;
+}
+
 enum target_xfer_status
 core_target::xfer_partial (enum target_object object, const char *annex,
 			   gdb_byte *readbuf, const gdb_byte *writebuf,
@@ -745,6 +825,11 @@ core_target::xfer_partial (enum target_object object, const char *annex,
   switch (object)
     {
     case TARGET_OBJECT_MEMORY:
+      /* The core file is only mapped for reading, so writes, which
+	 need "set write on", still go through BFD.  */
+      if (readbuf != NULL && core_bfd->direction == read_direction)
+	return read_memory (readbuf, offset, len, xfered_len);
+
       return (section_table_xfer_memory_partial
 	      (readbuf, writebuf,
 	       offset, len, xfered_len,
@@ -24,6 +24,7 @@
 #include "target-dcache.h"
 #include "inferior.h"
 #include "splay-tree.h"
+#include "common/byte-vector.h"
 
 /* Commands with a prefix of `{set,show} dcache'.  */
 static struct cmd_list_element *dcache_set_list = NULL;
@@ -344,6 +345,74 @@ dcache_read_line (DCACHE *dcache, struct dcache_block *db)
   return 1;
 }
 
+/* Fill the lines covering LEN bytes at MEMADDR that are not cached
+   yet, with a single target request if the target can read several
+   ranges of memory at once.  This saves a round trip per line on
+   remote targets.  Lines that cannot be read this way are left for
+   dcache_read_line.  */
+
+static void
+dcache_read_lines (DCACHE *dcache, CORE_ADDR memaddr, ULONGEST len)
+{
+  CORE_ADDR addr = MASK (dcache, memaddr);
+  ULONGEST nlines = ((XFORM (dcache, memaddr) + len + dcache->line_size - 1)
+		     / dcache->line_size);
+  std::vector<memory_read_request> ranges;
+  ULONGEST missing = 0;
+
+  /* Don't read more lines than the cache can hold.  */
+  if (nlines > dcache_size)
+    nlines = dcache_size;
+
+  for (ULONGEST i = 0; i < nlines; i++, addr += dcache->line_size)
+    {
+      struct mem_region *region;
+
+      if (splay_tree_lookup (dcache->tree, (splay_tree_key) addr) != NULL)
+	continue;
+
+      /* Lines split by a memory region boundary are read piecewise by
+	 dcache_read_line.  */
+      region = lookup_mem_region (addr);
+      if (region->attrib.mode == MEM_WO
+	  || (region->hi != 0 && addr + dcache->line_size > region->hi))
+	continue;
+
+      if (!ranges.empty ()
+	  && ranges.back ().addr + ranges.back ().len == addr)
+	ranges.back ().len += dcache->line_size;
+      else
+	ranges.push_back ({addr, dcache->line_size, NULL, 0});
+      missing++;
+    }
+
+  /* A single line costs one request either way.  */
+  if (missing < 2)
+    return;
+
+  gdb::byte_vector data (missing * dcache->line_size);
+  gdb_byte *p = data.data ();
+
+  for (memory_read_request &range : ranges)
+    {
+      range.buf = p;
+      p += range.len;
+    }
+
+  if (!target_read_raw_memory_ranges (ranges))
+    return;
+
+  for (const memory_read_request &range : ranges)
+    for (ULONGEST offset = 0;
+	 offset + dcache->line_size <= range.xfered_len;
+	 offset += dcache->line_size)
+      {
+	struct dcache_block *db = dcache_alloc (dcache, range.addr + offset);
+
+	memcpy (db->data, range.buf + offset, dcache->line_size);
+      }
+}
+
 /* Get a free cache block, put or keep it on the valid list,
    and return its address.  */
 
@@ -478,6 +547,9 @@ dcache_read_memory_partial (struct target_ops *ops, DCACHE *dcache,
       dcache->ptid = inferior_ptid;
     }
 
+  if (XFORM (dcache, memaddr) + len > dcache->line_size)
+    dcache_read_lines (dcache, memaddr, len);
+
   for (i = 0; i < len; i++)
     {
       if (!dcache_peek_byte (dcache, memaddr + i, myaddr + i))
@@ -27,6 +27,7 @@
 #include "common/pathstuff.h"
 #include "dwarf-index-write.h"
 #include "dwarf2read.h"
+#include "event-loop.h"
 #include "objfiles.h"
 #include "common/selftest.h"
 #include <string>
@@ -38,6 +39,13 @@ static int debug_index_cache = 0;
 /* The index cache directory, used for "set/show index-cache directory".  */
 static char *index_cache_directory = NULL;
 
+/* The value of "set/show index-cache background".  */
+static int index_cache_background = 0;
+
+/* Event handler used to write out the deferred index stores once GDB
+   gets back to its event loop.  */
+static async_event_handler *pending_stores_event_handler;
+
 /* See dwarf-index.cache.h.  */
 index_cache global_index_cache;
 
@@ -85,11 +93,77 @@ index_cache::disable ()
 
 /* See dwarf-index-cache.h.  */
 
+void
+index_cache::set_background (bool background)
+{
+  m_background = background;
+
+  /* Don't keep stores waiting for an event that may not come soon.  */
+  if (!m_background)
+    flush_pending_stores ();
+}
+
+/* See dwarf-index-cache.h.  */
+
 void
 index_cache::store (struct dwarf2_per_objfile *dwarf2_per_objfile)
+{
+  if (!enabled ())
+    return;
+
+  if (!m_background)
+    {
+      store_now (dwarf2_per_objfile);
+      return;
+    }
+
+  if (debug_index_cache)
+    printf_unfiltered ("index cache: deferring store for objfile %s\n",
+		       objfile_name (dwarf2_per_objfile->objfile));
+
+  m_pending_stores.push_back (dwarf2_per_objfile);
+  mark_async_event_handler (pending_stores_event_handler);
+}
+
+/* See dwarf-index-cache.h.  */
+
+void
+index_cache::flush_pending_stores ()
+{
+  /* Storing an index can't add new pending stores, but take the whole
+     list first anyway so that this is safe to re-enter.  */
+  std::vector<struct dwarf2_per_objfile *> pending
+    = std::move (m_pending_stores);
+  m_pending_stores.clear ();
+
+  for (dwarf2_per_objfile *per_objfile : pending)
+    store_now (per_objfile);
+}
+
+/* See dwarf-index-cache.h.  */
+
+void
+index_cache::flush_pending_store
+  (struct dwarf2_per_objfile *dwarf2_per_objfile)
+{
+  auto iter = std::find (m_pending_stores.begin (), m_pending_stores.end (),
+			 dwarf2_per_objfile);
+
+  if (iter != m_pending_stores.end ())
+    {
+      m_pending_stores.erase (iter);
+      store_now (dwarf2_per_objfile);
+    }
+}
+
+/* See dwarf-index-cache.h.  */
+
+void
+index_cache::store_now (struct dwarf2_per_objfile *dwarf2_per_objfile)
 {
   objfile *obj = dwarf2_per_objfile->objfile;
 
+  /* The cache may have been disabled while this store was pending.  */
   if (!enabled ())
     return;
 
@@ -281,6 +355,43 @@ set_index_cache_directory_command (const char *arg, int from_tty,
   global_index_cache.set_directory (index_cache_directory);
 }
 
+/* "set index-cache background" handler.  */
+
+static void
+set_index_cache_background_command (const char *arg, int from_tty,
+				    cmd_list_element *element)
+{
+  global_index_cache.set_background (index_cache_background != 0);
+}
+
+/* "show index-cache background" handler.  */
+
+static void
+show_index_cache_background_command (struct ui_file *file, int from_tty,
+				     struct cmd_list_element *c,
+				     const char *value)
+{
+  fprintf_filtered (file, _("Storing index files in the background is %s.\n"),
+		    value);
+}
+
+/* Async event handler for deferred index stores.  */
+
+static void
+pending_stores_event_handler_func (gdb_client_data data)
+{
+  global_index_cache.flush_pending_stores ();
+}
+
+/* Final cleanup writing out the stores that are still deferred when GDB
+   exits.  */
+
+static void
+flush_pending_stores_at_exit (void *arg)
+{
+  global_index_cache.flush_pending_stores ();
+}
+
 /* "show index-cache stats" handler.  */
 
 static void
@@ -342,6 +453,25 @@ _initialize_index_cache ()
 			    &set_index_cache_prefix_list,
 			    &show_index_cache_prefix_list);
 
+  /* set index-cache background */
+  add_setshow_boolean_cmd ("background", class_files, &index_cache_background,
+			   _("\
+Set whether index files are stored in the background."),
+			   _("\
+Show whether index files are stored in the background."),
+			   _("\
+When on, the index of a newly read objfile is not written to the cache\n\
+right after its symbols are read, but later, when GDB is idle.  This makes\n\
+the first load of a program without a cached index faster."),
+			   set_index_cache_background_command,
+			   show_index_cache_background_command,
+			   &set_index_cache_prefix_list,
+			   &show_index_cache_prefix_list);
+
+  pending_stores_event_handler
+    = create_async_event_handler (pending_stores_event_handler_func, NULL);
+  make_final_cleanup (flush_pending_stores_at_exit, NULL);
+
   /* show index-cache stats */
   add_cmd ("stats", class_files, show_index_cache_stats_command,
 	   _("Show some stats about the index cache."),
@@ -52,9 +52,28 @@ public:
   /* Disable the cache.  */
   void disable ();
 
-  /* Store an index for the specified object file in the cache.  */
+  /* Store an index for the specified object file in the cache.  If
+     background stores are enabled, the index is only written later, when
+     GDB is idle; see flush_pending_stores.  */
   void store (struct dwarf2_per_objfile *dwarf2_per_objfile);
 
+  /* Return true if index stores are deferred until GDB is idle.  */
+  bool background () const
+  {
+    return m_background;
+  }
+
+  /* Enable or disable deferring index stores until GDB is idle.  */
+  void set_background (bool background);
+
+  /* Write out all the indices whose store was deferred.  */
+  void flush_pending_stores ();
+
+  /* If the store of the index of DWARF2_PER_OBJFILE was deferred, write
+     it out now.  This is used before DWARF2_PER_OBJFILE is destroyed,
+     whether its objfile is freed or its symbols are re-read.  */
+  void flush_pending_store (struct dwarf2_per_objfile *dwarf2_per_objfile);
+
   /* Look for an index file matching BUILD_ID.  If found, return the contents
      as an array_view and store the underlying resources (allocated memory,
      mapped file, etc) in RESOURCE.  The returned array_view is valid as long
@@ -89,6 +108,9 @@ public:
 
 private:
 
+  /* Write the index of DWARF2_PER_OBJFILE to the cache directory.  */
+  void store_now (struct dwarf2_per_objfile *dwarf2_per_objfile);
+
   /* Compute the absolute filename where the index of the objfile with build
      id BUILD_ID will be stored.  SUFFIX is appended at the end of the
      filename.  */
@@ -101,6 +123,13 @@ private:
   /* Whether the cache is enabled.  */
   bool m_enabled = false;
 
+  /* Whether index stores are deferred until GDB is idle.  */
+  bool m_background = false;
+
+  /* The objfiles whose index still has to be stored, in the order their
+     stores were requested.  */
+  std::vector<struct dwarf2_per_objfile *> m_pending_stores;
+
   /* Number of cache hits and misses during this GDB session.  */
   unsigned int m_n_hits = 0;
   unsigned int m_n_misses = 0;
@@ -39,6 +39,10 @@
 #include "ax.h"
 #include "dwarf2loc.h"
 #include "dwarf2-frame-tailcall.h"
+#include "gdb_bfd.h"
+#include "gdbcmd.h"
+#include <list>
+#include <unordered_map>
 #if GDB_SELF_TEST
 #include "common/selftest.h"
 #include "selftest-arch.h"
@@ -126,10 +130,21 @@ struct dwarf2_fde
   unsigned char eh_frame_p;
 };
 
+struct eh_frame_hdr_table;
+struct dwarf2_cfa_cache;
+
 struct dwarf2_fde_table
 {
   int num_entries;
   struct dwarf2_fde **entries;
+
+  /* If non-NULL, the FDEs were not decoded up front and ENTRIES is
+     empty; FDEs are looked up in this .eh_frame_hdr table instead.  */
+  struct eh_frame_hdr_table *hdr_table;
+
+  /* The register rules computed for PCs covered by these FDEs, or
+     NULL if none have been cached yet.  */
+  struct dwarf2_cfa_cache *cfa_cache;
 };
 
 /* A minimal decoding of DWARF2 compilation units.  We only decode
@@ -158,6 +173,45 @@ struct comp_unit
   bfd_vma tbase;
 };
 
+/* The binary search table of an .eh_frame_hdr section, used to find
+   the FDEs in the corresponding .eh_frame section without decoding
+   all of them.  */
+
+struct eh_frame_hdr_table
+{
+  ~eh_frame_hdr_table ()
+  {
+    xfree (cie_table.entries);
+  }
+
+  /* The .eh_frame section.  */
+  struct comp_unit *unit;
+
+  /* The address of the .eh_frame_hdr section.  The addresses in
+     ENTRIES are relative to it.  */
+  CORE_ADDR hdr_vma;
+
+  /* FDE_COUNT pairs of the 4-byte initial location and the 4-byte
+     address of an FDE, sorted by initial location.  */
+  const gdb_byte *entries;
+  ULONGEST fde_count;
+
+  /* The CIEs decoded so far.  */
+  struct dwarf2_cie_table cie_table {0, NULL};
+
+  /* The FDEs decoded so far, by index in ENTRIES.  A NULL FDE means
+     the entry could not be decoded, or describes no code.  */
+  std::unordered_map<ULONGEST, struct dwarf2_fde *> fdes;
+};
+
+/* The FDE table of each objfile.  */
+
+const struct objfile_data *dwarf2_frame_objfile_data;
+
+/* Whether to look FDEs up in .eh_frame_hdr sections.  */
+
+static int dwarf2_frame_use_eh_frame_hdr = 1;
+
 static struct dwarf2_fde *dwarf2_frame_find_fde (CORE_ADDR *pc,
 						 CORE_ADDR *out_offset);
 
@@ -968,6 +1022,154 @@ struct dwarf2_frame_cache
   int entry_cfa_sp_offset_p;
 };
 
+/* The register rules at a PC, as computed by running the CFI
+   programs of the CIE and the FDE for that PC.  */
+
+struct dwarf2_cfa_row
+{
+  /* The rules for the CFA and each register.  PREV is always NULL.  */
+  struct dwarf2_frame_state_reg_info regs;
+
+  /* The location the rules apply from, relative to the start of the
+     FDE.  */
+  CORE_ADDR pc_offset;
+
+  /* Whether the ARM compilers quirk of reversed CFA offsets applies.  */
+  bool armcc_cfa_offsets_reversed;
+
+  /* The CFA's offset from the SP at the function's entry, if known.  */
+  LONGEST entry_cfa_sp_offset;
+  int entry_cfa_sp_offset_p;
+};
+
+/* The key of a row in the CFA rule cache: the FDE, the offset of the
+   PC from the start of the FDE, and the architecture the rules were
+   computed for.  */
+
+struct dwarf2_cfa_key
+{
+  bool operator== (const dwarf2_cfa_key &other) const
+  {
+    return (fde == other.fde
+	    && pc_offset == other.pc_offset
+	    && gdbarch == other.gdbarch);
+  }
+
+  struct dwarf2_fde *fde;
+  CORE_ADDR pc_offset;
+  struct gdbarch *gdbarch;
+};
+
+struct hash_dwarf2_cfa_key
+{
+  size_t operator() (const dwarf2_cfa_key &key) const
+  {
+    return (std::hash<struct dwarf2_fde *> () (key.fde)
+	    ^ std::hash<CORE_ADDR> () (key.pc_offset) * 31
+	    ^ std::hash<struct gdbarch *> () (key.gdbarch));
+  }
+};
+
+/* A cache of register rule rows for the FDEs of an objfile, so that
+   unwinding many frames stopped at the same PCs (e.g., the threads of
+   a process blocked in the same functions) runs the CFI programs only
+   once per PC.  The least recently used rows are evicted first.  */
+
+struct dwarf2_cfa_cache
+{
+  typedef std::list<std::pair<dwarf2_cfa_key, dwarf2_cfa_row>> row_list;
+
+  /* The rows, most recently used first.  */
+  row_list rows;
+
+  /* Index of ROWS.  */
+  std::unordered_map<dwarf2_cfa_key, row_list::iterator,
+		     hash_dwarf2_cfa_key> index;
+
+  /* Statistics, for "maint info dwarf-cfa-cache".  */
+  unsigned long hits = 0;
+  unsigned long misses = 0;
+  unsigned long evictions = 0;
+};
+
+/* The maximum number of rows in the CFA rule cache of each objfile.
+   Zero disables the cache.  */
+
+static unsigned int dwarf2_cfa_cache_size = 1024;
+
+/* Copy the CFA and register rules of SRC to DST, but not its stack of
+   remembered states.  */
+
+static void
+copy_cfa_rules (struct dwarf2_frame_state_reg_info *dst,
+		const struct dwarf2_frame_state_reg_info &src)
+{
+  dst->reg = src.reg;
+  dst->cfa_offset = src.cfa_offset;
+  dst->cfa_reg = src.cfa_reg;
+  dst->cfa_how = src.cfa_how;
+  dst->cfa_exp = src.cfa_exp;
+}
+
+/* Return the FDE table of the objfile FDE comes from.  */
+
+static struct dwarf2_fde_table *
+fde_table_of_fde (struct dwarf2_fde *fde)
+{
+  return ((struct dwarf2_fde_table *)
+	  objfile_data (fde->cie->unit->objfile, dwarf2_frame_objfile_data));
+}
+
+/* Look up KEY in the CFA rule cache, counting a hit or a miss.  */
+
+static const struct dwarf2_cfa_row *
+dwarf2_cfa_cache_lookup (const dwarf2_cfa_key &key)
+{
+  struct dwarf2_fde_table *fde_table = fde_table_of_fde (key.fde);
+  struct dwarf2_cfa_cache *cfa_cache = fde_table->cfa_cache;
+
+  if (dwarf2_cfa_cache_size == 0)
+    return NULL;
+
+  if (cfa_cache == NULL)
+    cfa_cache = fde_table->cfa_cache = new dwarf2_cfa_cache;
+
+  auto it = cfa_cache->index.find (key);
+  if (it == cfa_cache->index.end ())
+    {
+      ++cfa_cache->misses;
+      return NULL;
+    }
+
+  ++cfa_cache->hits;
+  cfa_cache->rows.splice (cfa_cache->rows.begin (), cfa_cache->rows,
+			  it->second);
+  return &it->second->second;
+}
+
+/* Record ROW as the register rules for KEY in the CFA rule cache,
+   evicting the least recently used rows to make room.  */
+
+static void
+dwarf2_cfa_cache_insert (const dwarf2_cfa_key &key,
+			 struct dwarf2_cfa_row &&row)
+{
+  struct dwarf2_cfa_cache *cfa_cache = fde_table_of_fde (key.fde)->cfa_cache;
+
+  if (cfa_cache == NULL || dwarf2_cfa_cache_size == 0)
+    return;
+
+  while (cfa_cache->rows.size () >= dwarf2_cfa_cache_size)
+    {
+      cfa_cache->index.erase (cfa_cache->rows.back ().first);
+      cfa_cache->rows.pop_back ();
+      ++cfa_cache->evictions;
+    }
+
+  cfa_cache->rows.emplace_front (key, std::move (row));
+  cfa_cache->index.emplace (key, cfa_cache->rows.begin ());
+}
+
 static struct dwarf2_frame_cache *
 dwarf2_frame_cache (struct frame_info *this_frame, void **this_cache)
 {
@@ -1001,7 +1203,8 @@ dwarf2_frame_cache (struct frame_info *this_frame, void **this_cache)
      get_frame_address_in_block does just this.  It's not clear how
      reliable the method is though; there is the potential for the
      register state pre-call being different to that on return.  */
-  CORE_ADDR pc1 = get_frame_address_in_block (this_frame);
+  CORE_ADDR pc = get_frame_address_in_block (this_frame);
+  CORE_ADDR pc1 = pc;
 
   /* Find the correct FDE.  */
   fde = dwarf2_frame_find_fde (&pc1, &cache->text_offset);
@@ -1012,37 +1215,58 @@ dwarf2_frame_cache (struct frame_info *this_frame, void **this_cache)
 
   cache->addr_size = fde->cie->addr_size;
 
-  /* Check for "quirks" - known bugs in producers.  */
-  dwarf2_frame_find_quirks (&fs, fde);
+  dwarf2_cfa_key key = { fde, pc - pc1, gdbarch };
+  const struct dwarf2_cfa_row *row = dwarf2_cfa_cache_lookup (key);
 
-  /* First decode all the insns in the CIE.  */
-  execute_cfa_program (fde, fde->cie->initial_instructions,
-		       fde->cie->end, gdbarch,
-		       get_frame_address_in_block (this_frame), &fs);
+  if (row != NULL)
+    {
+      /* We computed the rules for this PC before.  */
+      copy_cfa_rules (&fs.regs, row->regs);
+      fs.pc = pc1 + row->pc_offset;
+      fs.armcc_cfa_offsets_reversed = row->armcc_cfa_offsets_reversed;
+      cache->entry_cfa_sp_offset = row->entry_cfa_sp_offset;
+      cache->entry_cfa_sp_offset_p = row->entry_cfa_sp_offset_p;
+    }
+  else
+    {
+      /* Check for "quirks" - known bugs in producers.  */
+      dwarf2_frame_find_quirks (&fs, fde);
 
-  /* Save the initialized register set.  */
-  fs.initial = fs.regs;
+      /* First decode all the insns in the CIE.  */
+      execute_cfa_program (fde, fde->cie->initial_instructions,
+			   fde->cie->end, gdbarch, pc, &fs);
 
-  if (get_frame_func_if_available (this_frame, &entry_pc))
-    {
-      /* Decode the insns in the FDE up to the entry PC.  */
-      instr = execute_cfa_program (fde, fde->instructions, fde->end, gdbarch,
-				   entry_pc, &fs);
+      /* Save the initialized register set.  */
+      fs.initial = fs.regs;
 
-      if (fs.regs.cfa_how == CFA_REG_OFFSET
-	  && (dwarf_reg_to_regnum (gdbarch, fs.regs.cfa_reg)
-	      == gdbarch_sp_regnum (gdbarch)))
+      if (get_frame_func_if_available (this_frame, &entry_pc))
 	{
-	  cache->entry_cfa_sp_offset = fs.regs.cfa_offset;
-	  cache->entry_cfa_sp_offset_p = 1;
+	  /* Decode the insns in the FDE up to the entry PC.  */
+	  instr = execute_cfa_program (fde, fde->instructions, fde->end,
+				       gdbarch, entry_pc, &fs);
+
+	  if (fs.regs.cfa_how == CFA_REG_OFFSET
+	      && (dwarf_reg_to_regnum (gdbarch, fs.regs.cfa_reg)
+		  == gdbarch_sp_regnum (gdbarch)))
+	    {
+	      cache->entry_cfa_sp_offset = fs.regs.cfa_offset;
+	      cache->entry_cfa_sp_offset_p = 1;
+	    }
 	}
+      else
+	instr = fde->instructions;
+
+      /* Then decode the insns in the FDE up to our target PC.  */
+      execute_cfa_program (fde, instr, fde->end, gdbarch, pc, &fs);
+
+      struct dwarf2_cfa_row new_row;
+      copy_cfa_rules (&new_row.regs, fs.regs);
+      new_row.pc_offset = fs.pc - pc1;
+      new_row.armcc_cfa_offsets_reversed = fs.armcc_cfa_offsets_reversed;
+      new_row.entry_cfa_sp_offset = cache->entry_cfa_sp_offset;
+      new_row.entry_cfa_sp_offset_p = cache->entry_cfa_sp_offset_p;
+      dwarf2_cfa_cache_insert (key, std::move (new_row));
     }
-  else
-    instr = fde->instructions;
-
-  /* Then decode the insns in the FDE up to our target PC.  */
-  execute_cfa_program (fde, instr, fde->end, gdbarch,
-		       get_frame_address_in_block (this_frame), &fs);
 
   try
     {
@@ -1463,8 +1687,6 @@ dwarf2_frame_cfa (struct frame_info *this_frame)
   return get_frame_base (this_frame);
 }
 
-const struct objfile_data *dwarf2_frame_objfile_data;
-
 static unsigned int
 read_1_byte (bfd *abfd, const gdb_byte *buf)
 {
@@ -1667,18 +1889,26 @@ find_cie (struct dwarf2_cie_table *cie_table, ULONGEST cie_pointer)
   return NULL;
 }
 
-/* Add a pointer to new CIE to the CIE_TABLE, allocating space for it.  */
+/* Add a pointer to new CIE to the CIE_TABLE, allocating space for it.
+   CIEs are usually added in section order, but lazily decoded ones
+   may come in any order, so keep the table sorted.  */
 static void
 add_cie (struct dwarf2_cie_table *cie_table, struct dwarf2_cie *cie)
 {
   const int n = cie_table->num_entries;
+  int i = n;
 
-  gdb_assert (n < 1
-              || cie_table->entries[n - 1]->cie_pointer < cie->cie_pointer);
+  while (i > 0 && cie_table->entries[i - 1]->cie_pointer > cie->cie_pointer)
+    i--;
+
+  gdb_assert (i < 1
+              || cie_table->entries[i - 1]->cie_pointer < cie->cie_pointer);
 
   cie_table->entries
     = XRESIZEVEC (struct dwarf2_cie *, cie_table->entries, n + 1);
-  cie_table->entries[n] = cie;
+  memmove (&cie_table->entries[i + 1], &cie_table->entries[i],
+	   (n - i) * sizeof (cie_table->entries[0]));
+  cie_table->entries[i] = cie;
   cie_table->num_entries = n + 1;
 }
 
@@ -1695,51 +1925,116 @@ bsearch_fde_cmp (const void *key, const void *element)
   return 1;
 }
 
-/* Find the FDE for *PC.  Return a pointer to the FDE, and store the
-   inital location associated with it into *PC.  */
+static bool init_eh_frame_hdr_table (struct objfile *objfile);
+static struct dwarf2_fde *eh_frame_hdr_find_fde
+  (struct eh_frame_hdr_table *hdr_table, CORE_ADDR seek_pc);
+
+/* Find the FDE for *PC in OBJFILE.  Return a pointer to the FDE, and
+   store the inital location associated with it into *PC.  Return NULL
+   if OBJFILE has no FDE for *PC.  */
 
 static struct dwarf2_fde *
-dwarf2_frame_find_fde (CORE_ADDR *pc, CORE_ADDR *out_offset)
+dwarf2_frame_find_fde_in_objfile (struct objfile *objfile, CORE_ADDR *pc,
+				  CORE_ADDR *out_offset)
 {
-  for (objfile *objfile : current_program_space->objfiles ())
+  struct dwarf2_fde_table *fde_table;
+  struct dwarf2_fde **p_fde;
+  CORE_ADDR offset;
+  CORE_ADDR seek_pc;
+
+  fde_table = ((struct dwarf2_fde_table *)
+	       objfile_data (objfile, dwarf2_frame_objfile_data));
+  if (fde_table == NULL)
     {
-      struct dwarf2_fde_table *fde_table;
-      struct dwarf2_fde **p_fde;
-      CORE_ADDR offset;
-      CORE_ADDR seek_pc;
-
+      if (!dwarf2_frame_use_eh_frame_hdr
+	  || !init_eh_frame_hdr_table (objfile))
+	dwarf2_build_frame_info (objfile);
       fde_table = ((struct dwarf2_fde_table *)
 		   objfile_data (objfile, dwarf2_frame_objfile_data));
-      if (fde_table == NULL)
-	{
-	  dwarf2_build_frame_info (objfile);
-	  fde_table = ((struct dwarf2_fde_table *)
-		       objfile_data (objfile, dwarf2_frame_objfile_data));
-	}
-      gdb_assert (fde_table != NULL);
+    }
+  gdb_assert (fde_table != NULL);
 
-      if (fde_table->num_entries == 0)
-	continue;
+  if (fde_table->hdr_table != NULL)
+    {
+      struct dwarf2_fde *fde;
 
       gdb_assert (objfile->section_offsets);
       offset = ANOFFSET (objfile->section_offsets, SECT_OFF_TEXT (objfile));
 
-      gdb_assert (fde_table->num_entries > 0);
-      if (*pc < offset + fde_table->entries[0]->initial_location)
-        continue;
-
-      seek_pc = *pc - offset;
-      p_fde = ((struct dwarf2_fde **)
-	       bsearch (&seek_pc, fde_table->entries, fde_table->num_entries,
-                        sizeof (fde_table->entries[0]), bsearch_fde_cmp));
-      if (p_fde != NULL)
-        {
-          *pc = (*p_fde)->initial_location + offset;
+      fde = eh_frame_hdr_find_fde (fde_table->hdr_table, *pc - offset);
+      if (fde != NULL)
+	{
+	  *pc = fde->initial_location + offset;
 	  if (out_offset)
 	    *out_offset = offset;
-          return *p_fde;
-        }
+	}
+      return fde;
     }
+
+  if (fde_table->num_entries == 0)
+    return NULL;
+
+  gdb_assert (objfile->section_offsets);
+  offset = ANOFFSET (objfile->section_offsets, SECT_OFF_TEXT (objfile));
+
+  gdb_assert (fde_table->num_entries > 0);
+  if (*pc < offset + fde_table->entries[0]->initial_location)
+    return NULL;
+
+  seek_pc = *pc - offset;
+  p_fde = ((struct dwarf2_fde **)
+	   bsearch (&seek_pc, fde_table->entries, fde_table->num_entries,
+		    sizeof (fde_table->entries[0]), bsearch_fde_cmp));
+  if (p_fde == NULL)
+    return NULL;
+
+  *pc = (*p_fde)->initial_location + offset;
+  if (out_offset)
+    *out_offset = offset;
+  return *p_fde;
+}
+
+/* Find the FDE for *PC.  Return a pointer to the FDE, and store the
+   inital location associated with it into *PC.  */
+
+static struct dwarf2_fde *
+dwarf2_frame_find_fde (CORE_ADDR *pc, CORE_ADDR *out_offset)
+{
+  struct dwarf2_fde *fde;
+  struct objfile *owner = NULL;
+  struct obj_section *osect = find_pc_section (*pc);
+
+  /* The FDE for a PC is normally in the objfile that contains it, or
+     in one of that objfile's separate debug files.  Look there first,
+     so that each lookup, which happens several times for each frame
+     unwound, doesn't have to search the FDE tables of every objfile
+     in a program with many shared libraries.  */
+  if (osect != NULL)
+    {
+      owner = osect->objfile;
+      if (owner->separate_debug_objfile_backlink != NULL)
+	owner = owner->separate_debug_objfile_backlink;
+
+      for (objfile *objfile : owner->separate_debug_objfiles ())
+	{
+	  fde = dwarf2_frame_find_fde_in_objfile (objfile, pc, out_offset);
+	  if (fde != NULL)
+	    return fde;
+	}
+    }
+
+  for (objfile *objfile : current_program_space->objfiles ())
+    {
+      if (owner != NULL
+	  && (objfile == owner
+	      || objfile->separate_debug_objfile_backlink == owner))
+	continue;
+
+      fde = dwarf2_frame_find_fde_in_objfile (objfile, pc, out_offset);
+      if (fde != NULL)
+	return fde;
+    }
+
   return NULL;
 }
 
@@ -2196,6 +2491,209 @@ qsort_fde_cmp (const void *a, const void *b)
   return (aa->initial_location < bb->initial_location) ? -1 : 1;
 }
 
+/* Set the bases for the DW_EH_PE_datarel and DW_EH_PE_textrel
+   encodings used in UNIT's .eh_frame section.  */
+
+static void
+set_eh_frame_bases (struct comp_unit *unit)
+{
+  asection *got, *txt;
+
+  /* FIXME: kettenis/20030602: This is the DW_EH_PE_datarel base
+     that is used for the i386/amd64 target, which currently is
+     the only target in GCC that supports/uses the
+     DW_EH_PE_datarel encoding.  */
+  got = bfd_get_section_by_name (unit->abfd, ".got");
+  if (got)
+    unit->dbase = got->vma;
+
+  /* GCC emits the DW_EH_PE_textrel encoding type on sh and ia64
+     so far.  */
+  txt = bfd_get_section_by_name (unit->abfd, ".text");
+  if (txt)
+    unit->tbase = txt->vma;
+}
+
+/* Decode the FDE of entry INDEX in HDR_TABLE.  Return NULL if it can't
+   be decoded, or describes no code.  */
+
+static struct dwarf2_fde *
+decode_eh_frame_hdr_fde (struct eh_frame_hdr_table *hdr_table,
+			 ULONGEST index)
+{
+  struct comp_unit *unit = hdr_table->unit;
+  const gdb_byte *entry = hdr_table->entries + index * 8;
+  CORE_ADDR fde_addr
+    = hdr_table->hdr_vma + (int32_t) read_4_bytes (unit->abfd, entry + 4);
+  CORE_ADDR eh_frame_vma
+    = bfd_get_section_vma (unit->abfd, unit->dwarf_frame_section);
+  struct dwarf2_fde_table fde_table = { 0, NULL, NULL, NULL };
+  struct dwarf2_fde *fde = NULL;
+
+  if (fde_addr < eh_frame_vma
+      || fde_addr - eh_frame_vma >= unit->dwarf_frame_size)
+    {
+      complaint (_("Invalid FDE address in .eh_frame_hdr of %s"),
+		 objfile_name (unit->objfile));
+      return NULL;
+    }
+
+  try
+    {
+      decode_frame_entry (unit,
+			  unit->dwarf_frame_buffer + (fde_addr - eh_frame_vma),
+			  1, &hdr_table->cie_table, &fde_table,
+			  EH_FDE_TYPE_ID);
+      if (fde_table.num_entries != 0)
+	fde = fde_table.entries[0];
+    }
+  catch (const gdb_exception_error &e)
+    {
+      complaint (_("skipping FDE in .eh_frame of %s: %s"),
+		 objfile_name (unit->objfile), e.what ());
+    }
+
+  xfree (fde_table.entries);
+  return fde;
+}
+
+/* Return the FDE in HDR_TABLE that covers SEEK_PC, an address that
+   has not been relocated, or NULL if there is none.  Only that FDE,
+   and its CIE, are decoded, the first time they are needed.  */
+
+static struct dwarf2_fde *
+eh_frame_hdr_find_fde (struct eh_frame_hdr_table *hdr_table,
+		       CORE_ADDR seek_pc)
+{
+  bfd *abfd = hdr_table->unit->abfd;
+  ULONGEST lo = 0, hi = hdr_table->fde_count;
+  struct dwarf2_fde *fde;
+
+  /* Find the last entry whose initial location is at or before
+     SEEK_PC.  */
+  while (lo < hi)
+    {
+      ULONGEST mid = lo + (hi - lo) / 2;
+      CORE_ADDR loc
+	= (hdr_table->hdr_vma
+	   + (int32_t) read_4_bytes (abfd, hdr_table->entries + mid * 8));
+
+      if (seek_pc < loc)
+	hi = mid;
+      else
+	lo = mid + 1;
+    }
+
+  if (lo == 0)
+    return NULL;
+
+  auto it = hdr_table->fdes.find (lo - 1);
+  if (it != hdr_table->fdes.end ())
+    fde = it->second;
+  else
+    {
+      fde = decode_eh_frame_hdr_fde (hdr_table, lo - 1);
+      hdr_table->fdes.emplace (lo - 1, fde);
+    }
+
+  if (fde == NULL
+      || seek_pc < fde->initial_location
+      || seek_pc >= fde->initial_location + fde->address_range)
+    return NULL;
+
+  return fde;
+}
+
+/* Set up OBJFILE's FDE table to find FDEs through its .eh_frame_hdr
+   section, decoding them only when they are looked up.  Return false,
+   leaving OBJFILE alone, if OBJFILE has no .eh_frame_hdr search table
+   in a format we understand, or if it also has a .debug_frame section,
+   whose FDEs would need merging with the .eh_frame ones.  */
+
+static bool
+init_eh_frame_hdr_table (struct objfile *objfile)
+{
+  bfd *abfd = objfile->obfd;
+  asection *hdr_sect, *sect;
+  const gdb_byte *hdr, *buf;
+  bfd_size_type hdr_size, size;
+
+  /* Separate debug files only have .debug_frame.  */
+  if (objfile->separate_debug_objfile_backlink != NULL)
+    return false;
+
+  hdr_sect = bfd_get_section_by_name (abfd, ".eh_frame_hdr");
+  if (hdr_sect == NULL
+      || (bfd_get_section_flags (abfd, hdr_sect) & SEC_HAS_CONTENTS) == 0)
+    return false;
+
+  dwarf2_get_section_info (objfile, DWARF2_DEBUG_FRAME, &sect, &buf, &size);
+  if (size != 0)
+    return false;
+
+  /* The header is a version byte, three encoding bytes, the address
+     of .eh_frame and the number of table entries.  Only accept the
+     encodings the GNU linkers and lld use.  */
+  hdr = gdb_bfd_map_section (hdr_sect, &hdr_size);
+  if (hdr == NULL
+      || hdr_size < 12
+      || hdr[0] != 1
+      || hdr[1] != (DW_EH_PE_pcrel | DW_EH_PE_sdata4)
+      || hdr[2] != DW_EH_PE_udata4
+      || hdr[3] != (DW_EH_PE_datarel | DW_EH_PE_sdata4))
+    return false;
+
+  CORE_ADDR hdr_vma = bfd_get_section_vma (abfd, hdr_sect);
+  CORE_ADDR eh_frame_addr
+    = hdr_vma + 4 + (int32_t) read_4_bytes (abfd, hdr + 4);
+  ULONGEST fde_count = read_4_bytes (abfd, hdr + 8);
+
+  if (fde_count > (hdr_size - 12) / 8)
+    return false;
+
+  dwarf2_get_section_info (objfile, DWARF2_EH_FRAME, &sect, &buf, &size);
+  if (size == 0 || bfd_get_section_vma (abfd, sect) != eh_frame_addr)
+    return false;
+
+  struct comp_unit *unit = XOBNEW (&objfile->objfile_obstack, comp_unit);
+  unit->abfd = abfd;
+  unit->objfile = objfile;
+  unit->dwarf_frame_section = sect;
+  unit->dwarf_frame_buffer = buf;
+  unit->dwarf_frame_size = size;
+  unit->dbase = 0;
+  unit->tbase = 0;
+  set_eh_frame_bases (unit);
+
+  struct eh_frame_hdr_table *hdr_table = new eh_frame_hdr_table;
+  hdr_table->unit = unit;
+  hdr_table->hdr_vma = hdr_vma;
+  hdr_table->entries = hdr + 12;
+  hdr_table->fde_count = fde_count;
+
+  struct dwarf2_fde_table *fde_table
+    = XOBNEW (&objfile->objfile_obstack, struct dwarf2_fde_table);
+  fde_table->num_entries = 0;
+  fde_table->entries = NULL;
+  fde_table->hdr_table = hdr_table;
+  fde_table->cfa_cache = NULL;
+
+  set_objfile_data (objfile, dwarf2_frame_objfile_data, fde_table);
+  return true;
+}
+
+/* Free the .eh_frame_hdr table and the CFA rule cache of OBJFILE's
+   FDE table ARG.  */
+
+static void
+dwarf2_frame_objfile_data_free (struct objfile *objfile, void *arg)
+{
+  struct dwarf2_fde_table *fde_table = (struct dwarf2_fde_table *) arg;
+
+  delete fde_table->hdr_table;
+  delete fde_table->cfa_cache;
+}
+
 void
 dwarf2_build_frame_info (struct objfile *objfile)
 {
@@ -2210,6 +2708,8 @@ dwarf2_build_frame_info (struct objfile *objfile)
 
   fde_table.num_entries = 0;
   fde_table.entries = NULL;
+  fde_table.hdr_table = NULL;
+  fde_table.cfa_cache = NULL;
 
   /* Build a minimal decoding of the DWARF2 compilation unit.  */
   unit = XOBNEW (&objfile->objfile_obstack, comp_unit);
@@ -2228,21 +2728,7 @@ dwarf2_build_frame_info (struct objfile *objfile)
                                &unit->dwarf_frame_size);
       if (unit->dwarf_frame_size)
         {
-          asection *got, *txt;
-
-          /* FIXME: kettenis/20030602: This is the DW_EH_PE_datarel base
-             that is used for the i386/amd64 target, which currently is
-             the only target in GCC that supports/uses the
-             DW_EH_PE_datarel encoding.  */
-          got = bfd_get_section_by_name (unit->abfd, ".got");
-          if (got)
-            unit->dbase = got->vma;
-
-          /* GCC emits the DW_EH_PE_textrel encoding type on sh and ia64
-             so far.  */
-          txt = bfd_get_section_by_name (unit->abfd, ".text");
-          if (txt)
-            unit->tbase = txt->vma;
+	  set_eh_frame_bases (unit);
 
 	  try
 	    {
@@ -2328,6 +2814,8 @@ dwarf2_build_frame_info (struct objfile *objfile)
 
   /* Copy fde_table to obstack: it is needed at runtime.  */
   fde_table2 = XOBNEW (&objfile->objfile_obstack, struct dwarf2_fde_table);
+  fde_table2->hdr_table = NULL;
+  fde_table2->cfa_cache = NULL;
 
   if (fde_table.num_entries == 0)
     {
@@ -2412,11 +2900,88 @@ show_dwarf_unwinders_enabled_p (struct ui_file *file, int from_tty,
 		    value);
 }
 
+/* Handle 'maintenance show dwarf cfa-cache-size'.  */
+
+static void
+show_dwarf_cfa_cache_size (struct ui_file *file, int from_tty,
+			   struct cmd_list_element *c, const char *value)
+{
+  fprintf_filtered (file,
+		    _("The maximum number of rows in the CFA rule cache "
+		      "of each object file is %s.\n"),
+		    value);
+}
+
+/* Implement the "maint info dwarf-cfa-cache" command.  */
+
+static void
+maintenance_info_dwarf_cfa_cache (const char *args, int from_tty)
+{
+  for (objfile *objfile : current_program_space->objfiles ())
+    {
+      struct dwarf2_fde_table *fde_table
+	= ((struct dwarf2_fde_table *)
+	   objfile_data (objfile, dwarf2_frame_objfile_data));
+
+      if (fde_table == NULL || fde_table->cfa_cache == NULL)
+	continue;
+
+      const dwarf2_cfa_cache &cfa_cache = *fde_table->cfa_cache;
+
+      printf_filtered (_("Objfile %s:\n"), objfile_name (objfile));
+      printf_filtered (_("  Lookups: %lu hits, %lu misses\n"),
+		       cfa_cache.hits, cfa_cache.misses);
+      printf_filtered (_("  Rows evicted from the cache: %lu\n"),
+		       cfa_cache.evictions);
+      printf_filtered (_("  Rows in the cache: %s\n"),
+		       pulongest (cfa_cache.rows.size ()));
+    }
+}
+
+/* Implement the "maint info dwarf-fde-tables" command.  */
+
+static void
+maintenance_info_dwarf_fde_tables (const char *args, int from_tty)
+{
+  for (objfile *objfile : current_program_space->objfiles ())
+    {
+      struct dwarf2_fde_table *fde_table
+	= ((struct dwarf2_fde_table *)
+	   objfile_data (objfile, dwarf2_frame_objfile_data));
+
+      if (fde_table == NULL)
+	continue;
+
+      printf_filtered (_("Objfile %s:\n"), objfile_name (objfile));
+      if (fde_table->hdr_table != NULL)
+	printf_filtered (_("  FDEs looked up through .eh_frame_hdr, "
+			   "%s of %s decoded\n"),
+			 pulongest (fde_table->hdr_table->fdes.size ()),
+			 pulongest (fde_table->hdr_table->fde_count));
+      else
+	printf_filtered (_("  All %d FDEs decoded up front\n"),
+			 fde_table->num_entries);
+    }
+}
+
+/* Handle 'maintenance show dwarf eh-frame-hdr'.  */
+
+static void
+show_dwarf_eh_frame_hdr (struct ui_file *file, int from_tty,
+			 struct cmd_list_element *c, const char *value)
+{
+  fprintf_filtered (file,
+		    _("Looking up FDEs through .eh_frame_hdr is %s.\n"),
+		    value);
+}
+
 void
 _initialize_dwarf2_frame (void)
 {
   dwarf2_frame_data = gdbarch_data_register_pre_init (dwarf2_frame_init);
-  dwarf2_frame_objfile_data = register_objfile_data ();
+  dwarf2_frame_objfile_data
+    = register_objfile_data_with_cleanup (NULL,
+					  dwarf2_frame_objfile_data_free);
 
   add_setshow_boolean_cmd ("unwinders", class_obscure,
 			   &dwarf2_frame_unwinders_enabled_p , _("\
@@ -2430,6 +2995,43 @@ architecture that doesn't support them will have no effect."),
 			   &set_dwarf_cmdlist,
 			   &show_dwarf_cmdlist);
 
+  add_setshow_boolean_cmd ("eh-frame-hdr", class_obscure,
+			   &dwarf2_frame_use_eh_frame_hdr, _("\
+Set whether FDEs are looked up through .eh_frame_hdr sections."), _("\
+Show whether FDEs are looked up through .eh_frame_hdr sections."), _("\
+When enabled, GDB uses the binary search table in an object file's\n\
+.eh_frame_hdr section to find the FDE for a PC, and decodes FDEs and\n\
+CIEs only when they are needed, instead of reading the whole .eh_frame\n\
+section up front.  This only affects object files whose frame\n\
+information has not been read yet."),
+			   NULL,
+			   show_dwarf_eh_frame_hdr,
+			   &set_dwarf_cmdlist,
+			   &show_dwarf_cmdlist);
+
+  add_setshow_zuinteger_cmd ("cfa-cache-size", class_obscure,
+			     &dwarf2_cfa_cache_size, _("\
+Set the size of the CFA rule cache of each object file."), _("\
+Show the size of the CFA rule cache of each object file."), _("\
+GDB caches the register rules it computes from the call frame\n\
+information for each PC it unwinds from, so that unwinding many\n\
+frames stopped at the same PCs is fast.  This sets the maximum number\n\
+of PCs cached for each object file.  Zero disables the cache."),
+			     NULL,
+			     show_dwarf_cfa_cache_size,
+			     &set_dwarf_cmdlist,
+			     &show_dwarf_cmdlist);
+
+  add_cmd ("dwarf-cfa-cache", class_maintenance,
+	   maintenance_info_dwarf_cfa_cache, _("\
+Print statistics about the DWARF CFA rule cache of each object file."),
+	   &maintenanceinfolist);
+
+  add_cmd ("dwarf-fde-tables", class_maintenance,
+	   maintenance_info_dwarf_fde_tables, _("\
+Print how the FDEs of each object file were read."),
+	   &maintenanceinfolist);
+
 #if GDB_SELF_TEST
   selftests::register_test_foreach_arch ("execute_cfa_program",
 					 selftests::execute_cfa_program_test);
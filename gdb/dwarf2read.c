@@ -266,6 +266,24 @@ struct mapped_debug_names final : public mapped_index_base
 
   const char *namei_to_name (uint32_t namei) const;
 
+  /* Look in the hash table for a name whose hash is FULL_HASH and for
+     which MATCHES returns true.  MATCHES is only called for the names
+     whose hash is FULL_HASH, in name table order.  Return the index of
+     the name found in the name table, or an empty optional if there is
+     none.  */
+  gdb::optional<uint32_t> find_name_index
+    (uint32_t full_hash,
+     gdb::function_view<bool (uint32_t namei)> matches) const;
+
+  /* Read the 32-bit value at ADDR, in the byte order of the index.  */
+  uint32_t read_uint32 (const uint32_t *addr) const
+  {
+    const gdb_byte *bytes = reinterpret_cast<const gdb_byte *> (addr);
+
+    return (dwarf5_byte_order == BFD_ENDIAN_BIG
+	    ? bfd_getb32 (bytes) : bfd_getl32 (bytes));
+  }
+
   /* Implementation of the mapped_index_base virtual interface, for
      the name_components cache.  */
 
@@ -1249,8 +1267,8 @@ struct attr_abbrev
 
 struct abbrev_table
 {
-  explicit abbrev_table (sect_offset off)
-    : sect_off (off)
+  abbrev_table (struct dwarf2_section_info *sec, sect_offset off)
+    : section (sec), sect_off (off)
   {
     m_abbrevs =
       XOBNEWVEC (&abbrev_obstack, struct abbrev_info *, ABBREV_HASH_SIZE);
@@ -1274,6 +1292,7 @@ struct abbrev_table
 
   /* Where the abbrev table came from.
      This is used as a sanity check when the table is used.  */
+  struct dwarf2_section_info *const section;
   const sect_offset sect_off;
 
   /* Storage for the abbrev table.  */
@@ -1290,6 +1309,46 @@ private:
 
 typedef std::unique_ptr<struct abbrev_table> abbrev_table_up;
 
+/* A cache of abbrev tables, keyed by section and offset.  Units often
+   share an abbrev table, in particular in LTO programs; while a cache is
+   installed in the dwarf2_per_objfile, each such table is decoded only
+   once and then used read-only by all the units that refer to it.  */
+
+class abbrev_cache
+{
+public:
+  abbrev_cache ();
+
+  DISABLE_COPY_AND_ASSIGN (abbrev_cache);
+
+  /* Return the abbrev table at SECT_OFF in SECTION, reading it in if it
+     is not in the cache yet.  The table is owned by the cache.  */
+  struct abbrev_table *get (struct dwarf2_per_objfile *dwarf2_per_objfile,
+			    struct dwarf2_section_info *section,
+			    sect_offset sect_off);
+
+  /* Return the number of tables in the cache.  */
+  size_t size () const
+  {
+    return htab_elements (m_tables.get ());
+  }
+
+private:
+  static hashval_t hash_table (const void *item);
+  static int eq_table (const void *lhs, const void *rhs);
+  static void del_table (void *item);
+
+  /* The key used to look up a table.  */
+  struct search_key
+  {
+    struct dwarf2_section_info *section;
+    sect_offset sect_off;
+  };
+
+  /* The tables, keyed by search_key.  */
+  htab_up m_tables;
+};
+
 /* Attributes have a name and a value.  */
 struct attribute
   {
@@ -1469,6 +1528,20 @@ show_dwarf_max_cache_age (struct ui_file *file, int from_tty,
 			    "DWARF compilation units is %s.\n"),
 		    value);
 }
+
+/* The upper bound, in bytes, on the memory used by the compilation
+   units kept in memory by the cache above.  When the cached units do
+   not fit, the least recently used ones are freed first.  -1 means
+   unlimited.  */
+static int dwarf_max_cache_size = -1;
+static void
+show_dwarf_max_cache_size (struct ui_file *file, int from_tty,
+			   struct cmd_list_element *c, const char *value)
+{
+  fprintf_filtered (file, _("The upper bound on the memory used by cached "
+			    "DWARF compilation units is %s.\n"),
+		    value);
+}
 
 /* local function prototypes */
 
@@ -2175,6 +2248,10 @@ static void free_dwo_files (htab_t dwo_files, struct objfile *objfile);
 
 dwarf2_per_objfile::~dwarf2_per_objfile ()
 {
+  /* Write out a deferred store of the index while the partial symbols
+     it is built from are still there.  */
+  global_index_cache.flush_pending_store (this);
+
   /* Cached DIE trees use xmalloc and the comp_unit_obstack.  */
   free_cached_comp_units ();
 
@@ -2568,6 +2645,31 @@ dwarf2_read_section (struct objfile *objfile, dwarf2_section_info *info)
     }
 }
 
+/* Advise the host that the LENGTH bytes at SECT_OFF in SECTION will be
+   read soon, so that mapped section contents can be paged in ahead of
+   the DIE reader.  This does nothing if SECTION's contents were copied
+   into memory.  */
+
+static void
+dwarf2_section_willneed (struct objfile *objfile,
+			 struct dwarf2_section_info *section,
+			 sect_offset sect_off, unsigned int length)
+{
+  asection *sectp;
+  bfd_size_type offset = to_underlying (sect_off);
+
+  dwarf2_read_section (objfile, section);
+  if (section->buffer == NULL)
+    return;
+
+  if (section->is_virtual)
+    offset += section->virtual_offset;
+
+  sectp = get_section_bfd_section (section);
+  gdb_assert (sectp != NULL);
+  gdb_bfd_section_willneed (sectp, offset, length);
+}
+
 /* A helper function that returns the size of a section in a safe way.
    If you are positive that the section has been read before using the
    size, then it is safe to refer to the dwarf2_section_info object's
@@ -3179,13 +3281,9 @@ create_addrmap_from_index (struct dwarf2_per_objfile *dwarf2_per_objfile,
   struct objfile *objfile = dwarf2_per_objfile->objfile;
   struct gdbarch *gdbarch = get_objfile_arch (objfile);
   const gdb_byte *iter, *end;
-  struct addrmap *mutable_map;
+  addrmap_builder builder;
   CORE_ADDR baseaddr;
 
-  auto_obstack temp_obstack;
-
-  mutable_map = addrmap_create_mutable (&temp_obstack);
-
   iter = index->address_table.data ();
   end = iter + index->address_table.size ();
 
@@ -3217,12 +3315,11 @@ create_addrmap_from_index (struct dwarf2_per_objfile *dwarf2_per_objfile,
 
       lo = gdbarch_adjust_dwarf2_addr (gdbarch, lo + baseaddr) - baseaddr;
       hi = gdbarch_adjust_dwarf2_addr (gdbarch, hi + baseaddr) - baseaddr;
-      addrmap_set_empty (mutable_map, lo, hi - 1,
-			 dwarf2_per_objfile->get_cu (cu_index));
+      builder.set_empty (lo, hi - 1, dwarf2_per_objfile->get_cu (cu_index));
     }
 
   objfile->partial_symtabs->psymtabs_addrmap
-    = addrmap_create_fixed (mutable_map, objfile->partial_symtabs->obstack ());
+    = builder.create_fixed (objfile->partial_symtabs->obstack ());
 }
 
 /* Read the address map data from DWARF-5 .debug_aranges, and use it to
@@ -3238,8 +3335,7 @@ create_addrmap_from_aranges (struct dwarf2_per_objfile *dwarf2_per_objfile,
   const CORE_ADDR baseaddr = ANOFFSET (objfile->section_offsets,
 				       SECT_OFF_TEXT (objfile));
 
-  auto_obstack temp_obstack;
-  addrmap *mutable_map = addrmap_create_mutable (&temp_obstack);
+  addrmap_builder builder;
 
   std::unordered_map<sect_offset,
 		     dwarf2_per_cu_data *,
@@ -3378,12 +3474,12 @@ create_addrmap_from_aranges (struct dwarf2_per_objfile *dwarf2_per_objfile,
 		   - baseaddr);
 	  end = (gdbarch_adjust_dwarf2_addr (gdbarch, end + baseaddr)
 		 - baseaddr);
-	  addrmap_set_empty (mutable_map, start, end - 1, per_cu);
+	  builder.set_empty (start, end - 1, per_cu);
 	}
     }
 
   objfile->partial_symtabs->psymtabs_addrmap
-    = addrmap_create_fixed (mutable_map, objfile->partial_symtabs->obstack ());
+    = builder.create_fixed (objfile->partial_symtabs->obstack ());
 }
 
 /* Find a slot in the mapped index INDEX for the object named NAME.
@@ -5024,41 +5120,109 @@ run_test ()
 
 #endif /* GDB_SELF_TEST */
 
-/* If FILE_MATCHER is NULL or if PER_CU has
-   dwarf2_per_cu_quick_data::MARK set (see
-   dw_expand_symtabs_matching_file_matcher), expand the CU and call
-   EXPANSION_NOTIFY on it.  */
+/* The CUs that dw2_expand_symtabs_matching, or its .debug_names
+   counterpart, decided to expand.  Rather than expanding each CU as
+   soon as a matching symbol names it, the CUs are collected here and
+   expanded together by EXPAND.  */
 
-static void
-dw2_expand_symtabs_matching_one
-  (struct dwarf2_per_cu_data *per_cu,
-   gdb::function_view<expand_symtabs_file_matcher_ftype> file_matcher,
-   gdb::function_view<expand_symtabs_exp_notify_ftype> expansion_notify)
+class dw2_expansion_batch
 {
-  if (file_matcher == NULL || per_cu->v.quick->mark)
+public:
+
+  explicit dw2_expansion_batch (dwarf2_per_objfile *per_objfile)
+    : m_per_objfile (per_objfile)
+  {
+  }
+
+  DISABLE_COPY_AND_ASSIGN (dw2_expansion_batch);
+
+  /* Add PER_CU to the batch, unless it is already expanded.  */
+  void add (dwarf2_per_cu_data *per_cu)
+  {
+    if (per_cu->v.quick->compunit_symtab == NULL)
+      m_cus.push_back (per_cu);
+  }
+
+  /* Expand every CU in the batch, and call EXPANSION_NOTIFY on each
+     one that got a symtab.  */
+  void expand
+    (gdb::function_view<expand_symtabs_exp_notify_ftype> expansion_notify);
+
+private:
+
+  dwarf2_per_objfile *m_per_objfile;
+
+  /* The CUs to expand, possibly with duplicates.  */
+  std::vector<dwarf2_per_cu_data *> m_cus;
+};
+
+void
+dw2_expansion_batch::expand
+  (gdb::function_view<expand_symtabs_exp_notify_ftype> expansion_notify)
+{
+  if (m_cus.empty ())
+    return;
+
+  /* Expand the CUs in the order they appear in their sections, so that
+     their DIEs are read front to back, and so that a CU referring to
+     its neighbours is likely to find them still in the cache.  */
+  std::sort (m_cus.begin (), m_cus.end (),
+	     [] (const dwarf2_per_cu_data *a, const dwarf2_per_cu_data *b)
     {
-      bool symtab_was_null
-	= (per_cu->v.quick->compunit_symtab == NULL);
+      if (a->section != b->section)
+	return std::less<dwarf2_section_info *> () (a->section, b->section);
+      return a->sect_off < b->sect_off;
+    });
+  m_cus.erase (std::unique (m_cus.begin (), m_cus.end ()), m_cus.end ());
+
+  /* Unlike dw2_instantiate_symtab, keep the CU cache across the whole
+     batch: a CU read in to resolve a reference from one CU in the
+     batch stays around for the next ones, subject to the usual aging
+     in dw2_do_instantiate_symtab.  */
+  free_cached_comp_units freer (m_per_objfile);
+  scoped_restore decrementer = increment_reading_symtab ();
+
+  for (dwarf2_per_cu_data *per_cu : m_cus)
+    {
+      QUIT;
+
+      /* It may have been expanded meanwhile, because an earlier CU in
+	 the batch referred to it.  */
+      if (per_cu->v.quick->compunit_symtab != NULL)
+	continue;
 
-      dw2_instantiate_symtab (per_cu, false);
+      dw2_do_instantiate_symtab (per_cu, false);
+      process_cu_includes (m_per_objfile);
 
       if (expansion_notify != NULL
-	  && symtab_was_null
 	  && per_cu->v.quick->compunit_symtab != NULL)
 	expansion_notify (per_cu->v.quick->compunit_symtab);
     }
 }
 
+/* If FILE_MATCHER is NULL or if PER_CU has
+   dwarf2_per_cu_quick_data::MARK set (see
+   dw_expand_symtabs_matching_file_matcher), add the CU to BATCH.  */
+
+static void
+dw2_expand_symtabs_matching_one
+  (struct dwarf2_per_cu_data *per_cu,
+   gdb::function_view<expand_symtabs_file_matcher_ftype> file_matcher,
+   dw2_expansion_batch &batch)
+{
+  if (file_matcher == NULL || per_cu->v.quick->mark)
+    batch.add (per_cu);
+}
+
 /* Helper for dw2_expand_matching symtabs.  Called on each symbol
-   matched, to expand corresponding CUs that were marked.  IDX is the
-   index of the symbol name that matched.  */
+   matched, to add the corresponding CUs that were marked to BATCH.
+   IDX is the index of the symbol name that matched.  */
 
 static void
 dw2_expand_marked_cus
   (struct dwarf2_per_objfile *dwarf2_per_objfile, offset_type idx,
    gdb::function_view<expand_symtabs_file_matcher_ftype> file_matcher,
-   gdb::function_view<expand_symtabs_exp_notify_ftype> expansion_notify,
-   search_domain kind)
+   dw2_expansion_batch &batch, search_domain kind)
 {
   offset_type *vec, vec_len, vec_idx;
   bool global_seen = false;
@@ -5125,8 +5289,7 @@ dw2_expand_marked_cus
 	}
 
       dwarf2_per_cu_data *per_cu = dwarf2_per_objfile->get_cutu (cu_index);
-      dw2_expand_symtabs_matching_one (per_cu, file_matcher,
-				       expansion_notify);
+      dw2_expand_symtabs_matching_one (per_cu, file_matcher, batch);
     }
 }
 
@@ -5228,14 +5391,17 @@ dw2_expand_symtabs_matching
   dw_expand_symtabs_matching_file_matcher (dwarf2_per_objfile, file_matcher);
 
   mapped_index &index = *dwarf2_per_objfile->index_table;
+  dw2_expansion_batch batch (dwarf2_per_objfile);
 
   dw2_expand_symtabs_matching_symbol (index, lookup_name,
 				      symbol_matcher,
 				      kind, [&] (offset_type idx)
     {
-      dw2_expand_marked_cus (dwarf2_per_objfile, idx, file_matcher,
-			     expansion_notify, kind);
+      dw2_expand_marked_cus (dwarf2_per_objfile, idx, file_matcher, batch,
+			     kind);
     });
+
+  batch.expand (expansion_notify);
 }
 
 /* A helper for dw2_find_pc_sect_compunit_symtab which finds the most specific
@@ -5763,6 +5929,46 @@ mapped_debug_names::namei_to_name (uint32_t namei) const
     (dwarf2_per_objfile, dwarf2_per_objfile->objfile->obfd, namei_string_offs);
 }
 
+/* See mapped_debug_names.  */
+
+gdb::optional<uint32_t>
+mapped_debug_names::find_name_index
+  (uint32_t full_hash, gdb::function_view<bool (uint32_t namei)> matches) const
+{
+  const uint32_t bucket = full_hash % bucket_count;
+  uint32_t namei = read_uint32 (bucket_table_reordered + bucket);
+  if (namei == 0)
+    return {};
+  --namei;
+  if (namei >= name_count)
+    {
+      complaint (_("Wrong .debug_names with name index %u but name_count=%u "
+		   "[in module %s]"),
+		 namei, name_count,
+		 objfile_name (dwarf2_per_objfile->objfile));
+      return {};
+    }
+
+  /* The hashes of a bucket are contiguous in the hash table.  Only check
+     the bucket of a hash when it differs from FULL_HASH, to detect the
+     end of the bucket; an equal hash is in the same bucket anyway.  */
+  for (; namei < name_count; ++namei)
+    {
+      const uint32_t namei_full_hash
+	= read_uint32 (hash_table_reordered + namei);
+
+      if (namei_full_hash == full_hash)
+	{
+	  if (matches (namei))
+	    return namei;
+	}
+      else if (namei_full_hash % bucket_count != bucket)
+	break;
+    }
+
+  return {};
+}
+
 /* Find a slot in .debug_names for the object named NAME.  If NAME is
    found, return pointer to its pool data.  If NAME cannot be found,
    return NULL.  */
@@ -5773,6 +5979,7 @@ dw2_debug_names_iterator::find_vec_in_debug_names
 {
   int (*cmp) (const char *, const char *);
 
+  gdb::unique_xmalloc_ptr<char> without_params;
   if (current_language->la_language == language_cplus
       || current_language->la_language == language_fortran
       || current_language->la_language == language_d)
@@ -5782,75 +5989,117 @@ dw2_debug_names_iterator::find_vec_in_debug_names
 
       if (strchr (name, '(') != NULL)
 	{
-	  gdb::unique_xmalloc_ptr<char> without_params
-	    = cp_remove_params (name);
+	  without_params = cp_remove_params (name);
 
 	  if (without_params != NULL)
-	    {
-	      name = without_params.get();
-	    }
+	    name = without_params.get ();
 	}
     }
 
   cmp = (case_sensitivity == case_sensitive_on ? strcmp : strcasecmp);
 
   const uint32_t full_hash = dwarf5_djb_hash (name);
-  uint32_t namei
-    = extract_unsigned_integer (reinterpret_cast<const gdb_byte *>
-				(map.bucket_table_reordered
-				 + (full_hash % map.bucket_count)), 4,
-				map.dwarf5_byte_order);
-  if (namei == 0)
+  gdb::optional<uint32_t> namei
+    = map.find_name_index (full_hash, [&] (uint32_t candidate)
+      {
+	const char *const namei_string = map.namei_to_name (candidate);
+
+#if 0 /* An expensive sanity check.  */
+	if (full_hash != dwarf5_djb_hash (namei_string))
+	  {
+	    complaint (_("Wrong .debug_names hash for string at index %u "
+			 "[in module %s]"),
+		       candidate,
+		       objfile_name (map.dwarf2_per_objfile->objfile));
+	    return false;
+	  }
+#endif
+
+	return cmp (namei_string, name) == 0;
+      });
+  if (!namei.has_value ())
     return NULL;
-  --namei;
-  if (namei >= map.name_count)
-    {
-      complaint (_("Wrong .debug_names with name index %u but name_count=%u "
-		   "[in module %s]"),
-		 namei, map.name_count,
-		 objfile_name (map.dwarf2_per_objfile->objfile));
-      return NULL;
-    }
 
-  for (;;)
-    {
-      const uint32_t namei_full_hash
-	= extract_unsigned_integer (reinterpret_cast<const gdb_byte *>
-				    (map.hash_table_reordered + namei), 4,
-				    map.dwarf5_byte_order);
-      if (full_hash % map.bucket_count != namei_full_hash % map.bucket_count)
-	return NULL;
+  const ULONGEST namei_entry_offs
+    = extract_unsigned_integer ((map.name_table_entry_offs_reordered
+				 + *namei * map.offset_size),
+				map.offset_size, map.dwarf5_byte_order);
+  return map.entry_pool + namei_entry_offs;
+}
 
-      if (full_hash == namei_full_hash)
-	{
-	  const char *const namei_string = map.namei_to_name (namei);
+#if GDB_SELF_TEST
 
-#if 0 /* An expensive sanity check.  */
-	  if (namei_full_hash != dwarf5_djb_hash (namei_string))
-	    {
-	      complaint (_("Wrong .debug_names hash for string at index %u "
-			   "[in module %s]"),
-			 namei, objfile_name (dwarf2_per_objfile->objfile));
-	      return NULL;
-	    }
-#endif
+namespace selftests { namespace debug_names_hash {
 
-	  if (cmp (namei_string, name) == 0)
-	    {
-	      const ULONGEST namei_entry_offs
-		= extract_unsigned_integer ((map.name_table_entry_offs_reordered
-					     + namei * map.offset_size),
-					    map.offset_size, map.dwarf5_byte_order);
-	      return map.entry_pool + namei_entry_offs;
-	    }
-	}
+/* Check mapped_debug_names::find_name_index on a small hand-made hash
+   table, in the byte order BYTE_ORDER.  */
 
-      ++namei;
-      if (namei >= map.name_count)
-	return NULL;
-    }
+static void
+check_find_name_index (bfd_endian byte_order)
+{
+  /* Three buckets.  Bucket 0 holds names 0 to 2, bucket 1 is empty and
+     bucket 2 holds names 3 and 4; names 1 and 2 share a hash.  */
+  static const uint32_t buckets[] = { 1, 0, 4 };
+  static const uint32_t hashes[] = { 3, 6, 6, 2, 5 };
+  static const char *const names[] = { "a", "b", "c", "d", "e" };
+
+  gdb_byte bucket_bytes[sizeof (buckets)];
+  gdb_byte hash_bytes[sizeof (hashes)];
+
+  for (size_t i = 0; i < ARRAY_SIZE (buckets); ++i)
+    store_unsigned_integer (bucket_bytes + i * 4, 4, byte_order, buckets[i]);
+  for (size_t i = 0; i < ARRAY_SIZE (hashes); ++i)
+    store_unsigned_integer (hash_bytes + i * 4, 4, byte_order, hashes[i]);
+
+  mapped_debug_names map (NULL);
+  map.dwarf5_byte_order = byte_order;
+  map.bucket_count = ARRAY_SIZE (buckets);
+  map.name_count = ARRAY_SIZE (hashes);
+  map.bucket_table_reordered
+    = reinterpret_cast<const uint32_t *> (bucket_bytes);
+  map.hash_table_reordered = reinterpret_cast<const uint32_t *> (hash_bytes);
+
+  /* Look for NAME with hash HASH, and return its index, or -1.  Also
+     check that only names with the right hash are compared.  */
+  auto find = [&] (uint32_t hash, const char *name)
+    {
+      gdb::optional<uint32_t> namei
+	= map.find_name_index (hash, [&] (uint32_t candidate)
+	  {
+	    SELF_CHECK (hashes[candidate] == hash);
+	    return strcmp (names[candidate], name) == 0;
+	  });
+      return namei.has_value () ? (int) *namei : -1;
+    };
+
+  SELF_CHECK (find (3, "a") == 0);
+  SELF_CHECK (find (6, "b") == 1);
+  SELF_CHECK (find (6, "c") == 2);
+  SELF_CHECK (find (6, "x") == -1);
+  SELF_CHECK (find (2, "d") == 3);
+  SELF_CHECK (find (5, "e") == 4);
+
+  /* Bucket 1 is empty.  */
+  SELF_CHECK (find (4, "a") == -1);
+
+  /* Hash 9 would be in bucket 0, the search must stop at name 3.  */
+  SELF_CHECK (find (9, "d") == -1);
+
+  /* Hash 8 would be in bucket 2, the last one.  */
+  SELF_CHECK (find (8, "e") == -1);
+}
+
+static void
+run_test ()
+{
+  check_find_name_index (BFD_ENDIAN_LITTLE);
+  check_find_name_index (BFD_ENDIAN_BIG);
 }
 
+}} // namespace selftests::debug_names_hash
+
+#endif /* GDB_SELF_TEST */
+
 const gdb_byte *
 dw2_debug_names_iterator::find_vec_in_debug_names
   (const mapped_debug_names &map, uint32_t namei)
@@ -6166,20 +6415,22 @@ dw2_debug_names_expand_symtabs_matching
   dw_expand_symtabs_matching_file_matcher (dwarf2_per_objfile, file_matcher);
 
   mapped_debug_names &map = *dwarf2_per_objfile->debug_names_table;
+  dw2_expansion_batch batch (dwarf2_per_objfile);
 
   dw2_expand_symtabs_matching_symbol (map, lookup_name,
 				      symbol_matcher,
 				      kind, [&] (offset_type namei)
     {
-      /* The name was matched, now expand corresponding CUs that were
-	 marked.  */
+      /* The name was matched, now collect the corresponding CUs that
+	 were marked.  */
       dw2_debug_names_iterator iter (map, kind, namei);
 
       struct dwarf2_per_cu_data *per_cu;
       while ((per_cu = iter.next ()) != NULL)
-	dw2_expand_symtabs_matching_one (per_cu, file_matcher,
-					 expansion_notify);
+	dw2_expand_symtabs_matching_one (per_cu, file_matcher, batch);
     });
+
+  batch.expand (expansion_notify);
 }
 
 const struct quick_symbol_functions dwarf2_debug_names_functions =
@@ -7302,11 +7553,21 @@ read_cutu_die_from_dwo (struct dwarf2_per_cu_data *this_cu,
       dwo_unit->length = get_cu_length (&cu->header);
     }
 
-  *result_dwo_abbrev_table
-    = abbrev_table_read_table (dwarf2_per_objfile, dwo_abbrev_section,
-			       cu->header.abbrev_sect_off);
+  struct abbrev_table *dwo_abbrev_table;
+  if (dwarf2_per_objfile->abbrev_table_cache != NULL)
+    dwo_abbrev_table
+      = dwarf2_per_objfile->abbrev_table_cache->get (dwarf2_per_objfile,
+						     dwo_abbrev_section,
+						     cu->header.abbrev_sect_off);
+  else
+    {
+      *result_dwo_abbrev_table
+	= abbrev_table_read_table (dwarf2_per_objfile, dwo_abbrev_section,
+				   cu->header.abbrev_sect_off);
+      dwo_abbrev_table = result_dwo_abbrev_table->get ();
+    }
   init_cu_die_reader (result_reader, cu, section, dwo_unit->dwo_file,
-		      result_dwo_abbrev_table->get ());
+		      dwo_abbrev_table);
 
   /* Read in the die, but leave space to copy over the attributes
      from the stub.  This has the benefit of simplifying the rest of
@@ -7475,6 +7736,7 @@ init_tu_and_read_dwo_dies (struct dwarf2_per_cu_data *this_cu,
       /* Link this CU into read_in_chain.  */
       this_cu->cu->read_in_chain = dwarf2_per_objfile->read_in_chain;
       dwarf2_per_objfile->read_in_chain = this_cu;
+      ++dwarf2_per_objfile->cu_cache_stats.nr_reads;
       /* The chain owns it now.  */
       new_cu.release ();
     }
@@ -7621,12 +7883,18 @@ init_cutu_and_read_dies (struct dwarf2_per_cu_data *this_cu,
       || peek_abbrev_code (abfd, info_ptr) == 0)
     return;
 
-  /* If we don't have them yet, read the abbrevs for this compilation unit.
-     And if we need to read them now, make sure they're freed when we're
-     done (own the table through ABBREV_TABLE_HOLDER).  */
+  /* If we don't have them yet, read the abbrevs for this compilation unit,
+     or find them in the abbrev cache.  And if we need to read them now,
+     make sure they're freed when we're done (own the table through
+     ABBREV_TABLE_HOLDER).  */
   abbrev_table_up abbrev_table_holder;
   if (abbrev_table != NULL)
     gdb_assert (cu->header.abbrev_sect_off == abbrev_table->sect_off);
+  else if (dwarf2_per_objfile->abbrev_table_cache != NULL)
+    abbrev_table
+      = dwarf2_per_objfile->abbrev_table_cache->get (dwarf2_per_objfile,
+						     abbrev_section,
+						     cu->header.abbrev_sect_off);
   else
     {
       abbrev_table_holder
@@ -7697,6 +7965,7 @@ init_cutu_and_read_dies (struct dwarf2_per_cu_data *this_cu,
       /* Link this CU into read_in_chain.  */
       this_cu->cu->read_in_chain = dwarf2_per_objfile->read_in_chain;
       dwarf2_per_objfile->read_in_chain = this_cu;
+      ++dwarf2_per_objfile->cu_cache_stats.nr_reads;
       /* The chain owns it now.  */
       new_cu.release ();
     }
@@ -8081,25 +8350,8 @@ process_psymtab_comp_unit_reader (const struct die_reader_specs *reader,
 
   end_psymtab_common (objfile, pst);
 
-  if (!VEC_empty (dwarf2_per_cu_ptr, cu->per_cu->imported_symtabs))
-    {
-      int i;
-      int len = VEC_length (dwarf2_per_cu_ptr, cu->per_cu->imported_symtabs);
-      struct dwarf2_per_cu_data *iter;
-
-      /* Fill in 'dependencies' here; we fill in 'users' in a
-	 post-pass.  */
-      pst->number_of_dependencies = len;
-      pst->dependencies
-	= objfile->partial_symtabs->allocate_dependencies (len);
-      for (i = 0;
-	   VEC_iterate (dwarf2_per_cu_ptr, cu->per_cu->imported_symtabs,
-			i, iter);
-	   ++i)
-	pst->dependencies[i] = iter->v.psymtab;
-
-      VEC_free (dwarf2_per_cu_ptr, cu->per_cu->imported_symtabs);
-    }
+  /* The 'dependencies' of PST are filled in by set_partial_dependencies
+     once all the imported units have been scanned as well.  */
 
   /* Get the list of files included in the current compilation unit,
      and build a psymtab for each of them.  */
@@ -8444,6 +8696,66 @@ process_skeletonless_type_units (struct dwarf2_per_objfile *dwarf2_per_objfile)
     }
 }
 
+/* Scan the partial units that were imported by the unit just
+   processed, and by any partial unit imported from those in turn.
+   Deferring them this way, rather than scanning an imported unit in
+   the middle of its importer, keeps the partial symbols of every
+   psymtab contiguous in the objfile's global and static lists, and
+   makes the scan of each unit independent of the others.  */
+
+static void
+process_imported_partial_units (struct dwarf2_per_objfile *dwarf2_per_objfile)
+{
+  while (!dwarf2_per_objfile->pending_partial_units.empty ())
+    {
+      pending_partial_unit pending
+	= dwarf2_per_objfile->pending_partial_units.back ();
+      dwarf2_per_objfile->pending_partial_units.pop_back ();
+
+      /* A unit can be imported several times before it is read.  */
+      if (pending.per_cu->v.psymtab == NULL)
+	process_psymtab_comp_unit (pending.per_cu, 1,
+				   pending.pretend_language);
+    }
+}
+
+/* Fill in the 'dependencies' field of each psymtab in
+   DWARF2_PER_OBJFILE from the list of units it imports.  This is done
+   after all units have been read, because imported units are only
+   scanned after their importer; see process_imported_partial_units.  */
+
+static void
+set_partial_dependencies (struct dwarf2_per_objfile *dwarf2_per_objfile)
+{
+  struct objfile *objfile = dwarf2_per_objfile->objfile;
+
+  for (dwarf2_per_cu_data *per_cu : dwarf2_per_objfile->all_comp_units)
+    {
+      struct partial_symtab *pst = per_cu->v.psymtab;
+
+      if (VEC_empty (dwarf2_per_cu_ptr, per_cu->imported_symtabs))
+	continue;
+
+      if (pst != NULL)
+	{
+	  int i;
+	  int len = VEC_length (dwarf2_per_cu_ptr, per_cu->imported_symtabs);
+	  struct dwarf2_per_cu_data *iter;
+
+	  pst->number_of_dependencies = len;
+	  pst->dependencies
+	    = objfile->partial_symtabs->allocate_dependencies (len);
+	  for (i = 0;
+	       VEC_iterate (dwarf2_per_cu_ptr, per_cu->imported_symtabs,
+			    i, iter);
+	       ++i)
+	    pst->dependencies[i] = iter->v.psymtab;
+	}
+
+      VEC_free (dwarf2_per_cu_ptr, per_cu->imported_symtabs);
+    }
+}
+
 /* Compute the 'user' field for each psymtab in DWARF2_PER_OBJFILE.  */
 
 static void
@@ -8487,6 +8799,12 @@ dwarf2_build_psymtabs_hard (struct dwarf2_per_objfile *dwarf2_per_objfile)
      read_in_chain.  Make sure to free them when we're done.  */
   free_cached_comp_units freer (dwarf2_per_objfile);
 
+  /* Decode each abbrev table only once, even if several units use it.
+     The tables are freed when we're done.  */
+  abbrev_cache abbrevs;
+  scoped_restore save_abbrev_table_cache
+    = make_scoped_restore (&dwarf2_per_objfile->abbrev_table_cache, &abbrevs);
+
   build_type_psymtabs (dwarf2_per_objfile);
 
   create_all_comp_units (dwarf2_per_objfile);
@@ -8500,7 +8818,10 @@ dwarf2_build_psymtabs_hard (struct dwarf2_per_objfile *dwarf2_per_objfile)
 			   addrmap_create_mutable (&temp_obstack));
 
   for (dwarf2_per_cu_data *per_cu : dwarf2_per_objfile->all_comp_units)
-    process_psymtab_comp_unit (per_cu, 0, language_minimal);
+    {
+      process_psymtab_comp_unit (per_cu, 0, language_minimal);
+      process_imported_partial_units (dwarf2_per_objfile);
+    }
 
   /* This has to wait until we read the CUs, we need the list of DWOs.  */
   process_skeletonless_type_units (dwarf2_per_objfile);
@@ -8513,8 +8834,13 @@ dwarf2_build_psymtabs_hard (struct dwarf2_per_objfile *dwarf2_per_objfile)
     }
 
   if (dwarf_read_debug)
-    print_tu_stats (dwarf2_per_objfile);
+    {
+      print_tu_stats (dwarf2_per_objfile);
+      fprintf_unfiltered (gdb_stdlog, "  Distinct abbrev tables read: %zu\n",
+			  abbrevs.size ());
+    }
 
+  set_partial_dependencies (dwarf2_per_objfile);
   set_partial_user (dwarf2_per_objfile);
 
   objfile->partial_symtabs->psymtabs_addrmap
@@ -8723,9 +9049,11 @@ scan_partial_symbols (struct partial_die_info *first_die, CORE_ADDR *lowpc,
 			   (pdi->d.sect_off, pdi->is_dwz,
 			    cu->per_cu->dwarf2_per_objfile);
 
-		/* Go read the partial unit, if needed.  */
+		/* Queue the partial unit to be read after this one, if
+		   needed.  */
 		if (per_cu->v.psymtab == NULL)
-		  process_psymtab_comp_unit (per_cu, 1, cu->language);
+		  cu->per_cu->dwarf2_per_objfile->pending_partial_units
+		    .push_back ({per_cu, cu->language});
 
 		VEC_safe_push (dwarf2_per_cu_ptr,
 			       cu->per_cu->imported_symtabs, per_cu);
@@ -9724,6 +10052,12 @@ load_full_comp_unit (struct dwarf2_per_cu_data *this_cu,
 {
   gdb_assert (! this_cu->is_debug_types);
 
+  /* The whole unit is about to be read; ask for it all at once rather
+     than faulting it in page by page.  */
+  dwarf2_section_willneed (this_cu->dwarf2_per_objfile->objfile,
+			   this_cu->section, this_cu->sect_off,
+			   this_cu->length);
+
   init_cutu_and_read_dies (this_cu, NULL, 1, 1, skip_partial,
 			   load_full_comp_unit_reader, &pretend_language);
 }
@@ -10350,6 +10684,8 @@ process_full_comp_unit (struct dwarf2_per_cu_data *per_cu,
 
   baseaddr = ANOFFSET (objfile->section_offsets, SECT_OFF_TEXT (objfile));
 
+  ++dwarf2_per_objfile->cu_cache_stats.nr_expansions;
+
   /* Clear the list here in case something was left over.  */
   cu->method_list.clear ();
 
@@ -10454,6 +10790,8 @@ process_full_type_unit (struct dwarf2_per_cu_data *per_cu,
   gdb_assert (per_cu->is_debug_types);
   sig_type = (struct signatured_type *) per_cu;
 
+  ++dwarf2_per_objfile->cu_cache_stats.nr_expansions;
+
   /* Clear the list here in case something was left over.  */
   cu->method_list.clear ();
 
@@ -18210,6 +18548,57 @@ abbrev_table::lookup_abbrev (unsigned int abbrev_number)
   return NULL;
 }
 
+abbrev_cache::abbrev_cache ()
+  : m_tables (htab_create_alloc (20, hash_table, eq_table, del_table,
+				 xcalloc, xfree))
+{
+}
+
+/* Hash function for the abbrev cache.  */
+
+hashval_t
+abbrev_cache::hash_table (const void *item)
+{
+  const struct search_key *key = (const struct search_key *) item;
+
+  return to_underlying (key->sect_off);
+}
+
+/* Comparison function for the abbrev cache.  LHS is a table in the cache
+   and RHS the search key.  */
+
+int
+abbrev_cache::eq_table (const void *lhs, const void *rhs)
+{
+  const struct abbrev_table *table = (const struct abbrev_table *) lhs;
+  const struct search_key *key = (const struct search_key *) rhs;
+
+  return table->section == key->section && table->sect_off == key->sect_off;
+}
+
+/* Deletion function for the abbrev cache.  */
+
+void
+abbrev_cache::del_table (void *item)
+{
+  delete (struct abbrev_table *) item;
+}
+
+struct abbrev_table *
+abbrev_cache::get (struct dwarf2_per_objfile *dwarf2_per_objfile,
+		   struct dwarf2_section_info *section, sect_offset sect_off)
+{
+  struct search_key key = { section, sect_off };
+  void **slot = htab_find_slot_with_hash (m_tables.get (), &key,
+					  to_underlying (sect_off), INSERT);
+
+  if (*slot == NULL)
+    *slot = abbrev_table_read_table (dwarf2_per_objfile, section,
+				     sect_off).release ();
+
+  return (struct abbrev_table *) *slot;
+}
+
 /* Read in an abbrev table.  */
 
 static abbrev_table_up
@@ -18226,7 +18615,7 @@ abbrev_table_read_table (struct dwarf2_per_objfile *dwarf2_per_objfile,
   struct attr_abbrev *cur_attrs;
   unsigned int allocated_attrs;
 
-  abbrev_table_up abbrev_table (new struct abbrev_table (sect_off));
+  abbrev_table_up abbrev_table (new struct abbrev_table (section, sect_off));
 
   dwarf2_read_section (objfile, section);
   abbrev_ptr = section->buffer + to_underlying (sect_off);
@@ -25263,12 +25652,13 @@ prepare_one_comp_unit (struct dwarf2_cu *cu, struct die_info *comp_unit_die,
 }
 
 /* Increase the age counter on each cached compilation unit, and free
-   any that are too old.  */
+   any that are too old, or that do not fit in the cache size limit.  */
 
 static void
 age_cached_comp_units (struct dwarf2_per_objfile *dwarf2_per_objfile)
 {
   struct dwarf2_per_cu_data *per_cu, **last_chain;
+  std::vector<dwarf2_cu *> young;
 
   dwarf2_clear_marks (dwarf2_per_objfile->read_in_chain);
   per_cu = dwarf2_per_objfile->read_in_chain;
@@ -25276,10 +25666,34 @@ age_cached_comp_units (struct dwarf2_per_objfile *dwarf2_per_objfile)
     {
       per_cu->cu->last_used ++;
       if (per_cu->cu->last_used <= dwarf_max_cache_age)
-	dwarf2_mark (per_cu->cu);
+	young.push_back (per_cu->cu);
       per_cu = per_cu->cu->read_in_chain;
     }
 
+  /* Keep the most recently used units first, so that if there is a
+     size limit, the coldest units are the ones that do not fit.  Units
+     that a kept unit depends on are kept too, even if that takes the
+     cache over the limit.  */
+  std::stable_sort (young.begin (), young.end (),
+		    [] (const dwarf2_cu *a, const dwarf2_cu *b)
+    {
+      return a->last_used < b->last_used;
+    });
+
+  size_t kept_size = 0;
+  for (dwarf2_cu *cu : young)
+    {
+      if (dwarf_max_cache_size >= 0)
+	{
+	  size_t size = obstack_memory_used (&cu->comp_unit_obstack);
+
+	  if (kept_size + size > (size_t) dwarf_max_cache_size)
+	    continue;
+	  kept_size += size;
+	}
+      dwarf2_mark (cu);
+    }
+
   per_cu = dwarf2_per_objfile->read_in_chain;
   last_chain = &dwarf2_per_objfile->read_in_chain;
   while (per_cu != NULL)
@@ -25292,6 +25706,7 @@ age_cached_comp_units (struct dwarf2_per_objfile *dwarf2_per_objfile)
 	{
 	  delete per_cu->cu;
 	  *last_chain = next_cu;
+	  ++dwarf2_per_objfile->cu_cache_stats.nr_evictions;
 	}
       else
 	last_chain = &per_cu->cu->read_in_chain;
@@ -25331,6 +25746,43 @@ free_one_cached_comp_unit (struct dwarf2_per_cu_data *target_per_cu)
     }
 }
 
+/* Implement the "maint info dwarf-cache" command.  */
+
+static void
+maintenance_info_dwarf_cache (const char *args, int from_tty)
+{
+  for (objfile *objfile : current_program_space->objfiles ())
+    {
+      struct dwarf2_per_objfile *dwarf2_per_objfile
+	= get_dwarf2_per_objfile (objfile);
+
+      if (dwarf2_per_objfile == NULL)
+	continue;
+
+      const cu_cache_stats &stats = dwarf2_per_objfile->cu_cache_stats;
+      int nr_cached = 0;
+      size_t cached_size = 0;
+
+      for (dwarf2_per_cu_data *per_cu = dwarf2_per_objfile->read_in_chain;
+	   per_cu != NULL;
+	   per_cu = per_cu->cu->read_in_chain)
+	{
+	  ++nr_cached;
+	  cached_size += obstack_memory_used (&per_cu->cu->comp_unit_obstack);
+	}
+
+      printf_filtered (_("Objfile %s:\n"), objfile_name (objfile));
+      printf_filtered (_("  Units expanded into symtabs: %d\n"),
+		       stats.nr_expansions);
+      printf_filtered (_("  Units read into the cache: %d\n"),
+		       stats.nr_reads);
+      printf_filtered (_("  Units evicted from the cache: %d\n"),
+		       stats.nr_evictions);
+      printf_filtered (_("  Units in the cache: %d, using %s bytes\n"),
+		       nr_cached, pulongest (cached_size));
+    }
+}
+
 /* Cleanup function for the dwarf2_per_objfile data.  */
 
 static void
@@ -25686,6 +26138,26 @@ caching, which can slow down startup."),
 			    &set_dwarf_cmdlist,
 			    &show_dwarf_cmdlist);
 
+  add_setshow_zuinteger_unlimited_cmd ("max-cache-size", class_obscure,
+				       &dwarf_max_cache_size, _("\
+Set the upper bound on the memory used by cached DWARF compilation units."),
+				       _("\
+Show the upper bound on the memory used by cached DWARF compilation units."),
+				       _("\
+This limits, in bytes, the memory used by the DIEs of the compilation\n\
+units that are kept in memory between expansions.  When the cached\n\
+units do not fit, the least recently used ones are freed first.\n\
+\"unlimited\" means no limit other than \"maint set dwarf max-cache-age\"."),
+				       NULL,
+				       show_dwarf_max_cache_size,
+				       &set_dwarf_cmdlist,
+				       &show_dwarf_cmdlist);
+
+  add_cmd ("dwarf-cache", class_maintenance, maintenance_info_dwarf_cache,
+	   _("\
+Print statistics about DWARF full symbol reading and its unit cache."),
+	   &maintenanceinfolist);
+
   add_setshow_boolean_cmd ("always-disassemble", class_obscure,
 			   &dwarf_always_disassemble, _("\
 Set whether `info address' always disassembles DWARF expressions."), _("\
@@ -25760,5 +26232,7 @@ Warning: This option must be enabled before gdb reads the file."),
 #if GDB_SELF_TEST
   selftests::register_test ("dw2_expand_symtabs_matching",
 			    selftests::dw2_expand_symtabs_matching::run_test);
+  selftests::register_test ("debug_names_hash",
+			    selftests::debug_names_hash::run_test);
 #endif
 }
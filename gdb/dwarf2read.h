@@ -92,6 +92,21 @@ struct tu_stats
   int nr_all_type_units_reallocs;
 };
 
+/* Statistics about full symbol reading, and about the cache of units
+   whose DIEs are kept in memory between expansions.  */
+
+struct cu_cache_stats
+{
+  /* Number of units expanded into full symtabs.  */
+  int nr_expansions;
+  /* Number of units whose DIEs were read in and added to the cache.  */
+  int nr_reads;
+  /* Number of units dropped from the cache because they aged out or
+     did not fit in the cache size limit.  */
+  int nr_evictions;
+};
+
+class abbrev_cache;
 struct dwarf2_debug_sections;
 struct mapped_index;
 struct mapped_debug_names;
@@ -99,6 +114,19 @@ struct signatured_type;
 struct die_info;
 typedef struct die_info *die_info_ptr;
 
+/* A partial unit that was imported while building partial symbols,
+   and which still has to be read.  */
+
+struct pending_partial_unit
+{
+  /* The imported unit.  */
+  dwarf2_per_cu_data *per_cu;
+
+  /* The language of the importing unit, used if the imported unit
+     does not say.  */
+  enum language pretend_language;
+};
+
 /* Collection of data recorded per objfile.
    This hangs off of dwarf2_objfile_data_key.  */
 
@@ -190,6 +218,9 @@ public:
      are doing.  */
   struct tu_stats tu_stats {};
 
+  /* Full symbol reading statistics, for "maint info dwarf-cache".  */
+  struct cu_cache_stats cu_cache_stats {};
+
   /* A chain of compilation units that are currently read in, so that
      they can be freed later.  */
   dwarf2_per_cu_data *read_in_chain = NULL;
@@ -235,6 +266,14 @@ public:
      symbols.  */
   bool reading_partial_symbols = false;
 
+  /* Partial units imported by the units read so far during partial
+     symbol reading, and which have not been read themselves yet.  */
+  std::vector<pending_partial_unit> pending_partial_units;
+
+  /* If non-NULL, the cache of abbrev tables in which units look for their
+     abbrev table.  This is only set while reading partial symbols.  */
+  abbrev_cache *abbrev_table_cache = nullptr;
+
   /* Table mapping type DIEs to their struct type *.
      This is NULL if not allocated yet.
      The mapping is done via (CU/TU + DIE offset) -> type.  */
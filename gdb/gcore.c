@@ -44,6 +44,11 @@
    generate-core-file for programs with large resident data.  */
 #define MAX_COPY_BYTES (1024 * 1024)
 
+/* The granularity at which all-zero memory is left out of the core
+   file.  Such blocks are not written at all, so they become holes in
+   the (freshly created) file, which read back as zeros.  */
+#define ZERO_BLOCK_BYTES 4096
+
 static const char *default_gcore_target (void);
 static enum bfd_architecture default_gcore_arch (void);
 static unsigned long default_gcore_mach (void);
@@ -527,6 +532,50 @@ objfile_find_memory_regions (struct target_ops *self,
   return 0;
 }
 
+/* Return true if the LEN bytes at P are all zero.  */
+
+static bool
+all_zeros_p (const gdb_byte *p, size_t len)
+{
+  return len == 0 || (p[0] == 0 && memcmp (p, p + 1, len - 1) == 0);
+}
+
+/* Write the SIZE bytes at BUF to OSEC at OFFSET, leaving out the
+   blocks of ZERO_BLOCK_BYTES that are all zero.  The runs of non-zero
+   blocks in between are written with one call each.  Return false if
+   writing failed.  */
+
+static bool
+gcore_write_sparse (bfd *obfd, asection *osec, const gdb_byte *buf,
+		    file_ptr offset, bfd_size_type size)
+{
+  bfd_size_type run_start = 0;
+  bfd_size_type pos = 0;
+
+  while (pos < size)
+    {
+      bfd_size_type len = std::min (size - pos,
+				    (bfd_size_type) ZERO_BLOCK_BYTES);
+
+      if (all_zeros_p (buf + pos, len))
+	{
+	  if (run_start < pos
+	      && !bfd_set_section_contents (obfd, osec, buf + run_start,
+					    offset + run_start,
+					    pos - run_start))
+	    return false;
+	  run_start = pos + len;
+	}
+      pos += len;
+    }
+
+  if (run_start < size)
+    return bfd_set_section_contents (obfd, osec, buf + run_start,
+				     offset + run_start, size - run_start);
+
+  return true;
+}
+
 static void
 gcore_copy_callback (bfd *obfd, asection *osec, void *ignored)
 {
@@ -558,8 +607,16 @@ gcore_copy_callback (bfd *obfd, asection *osec, void *ignored)
 		   paddress (target_gdbarch (), bfd_section_vma (obfd, osec)));
 	  break;
 	}
-      if (!bfd_set_section_contents (obfd, osec, memhunk.data (),
-				     offset, size))
+      /* Write the last byte of the section even if it is zero, so
+	 that the file extends over any hole at the end.  */
+      bool last = size == total_size;
+
+      if (!gcore_write_sparse (obfd, osec, memhunk.data (), offset,
+			       last ? size - 1 : size)
+	  || (last
+	      && !bfd_set_section_contents (obfd, osec,
+					    memhunk.data () + size - 1,
+					    offset + size - 1, 1)))
 	{
 	  warning (_("Failed to write corefile contents (%s)."),
 		   bfd_errmsg (bfd_get_error ()));
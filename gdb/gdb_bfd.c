@@ -45,8 +45,11 @@ struct gdb_bfd_section_data
   bfd_size_type map_len;
   /* The data.  If NULL, the section data has not been read.  */
   void *data;
-  /* If the data was mmapped, this is the map address.  */
+  /* If the data was mmapped on its own, this is the map address.  */
   void *map_addr;
+  /* This is true if the data points into the mapping of the whole
+     file; see gdb_bfd_data::file_map_addr.  */
+  unsigned int in_file_map : 1;
 };
 
 /* A hash table holding every BFD that gdb knows about.  This is not
@@ -65,7 +68,8 @@ struct gdb_bfd_data
       size (bfd_get_size (abfd)),
       relocation_computed (0),
       needs_relocations (0),
-      crc_computed (0)
+      crc_computed (0),
+      file_map_computed (0)
   {
     struct stat buf;
 
@@ -84,6 +88,13 @@ struct gdb_bfd_data
 
   ~gdb_bfd_data ()
   {
+#ifdef HAVE_MMAP
+    if (file_map_addr != NULL)
+      {
+	int res = munmap (file_map_addr, file_map_len);
+	gdb_assert (res == 0);
+      }
+#endif
   }
 
   /* The reference count.  */
@@ -111,9 +122,20 @@ struct gdb_bfd_data
   /* This is true if we have successfully computed the file's CRC.  */
   unsigned int crc_computed : 1;
 
+  /* This is true if we have tried to map the whole file.  */
+  unsigned int file_map_computed : 1;
+
   /* The file's CRC.  */
   unsigned long crc = 0;
 
+  /* If the whole file was mmapped, this is the start of the file's
+     contents within the map, and FILE_MAP_ADDR and FILE_MAP_LEN
+     describe the map itself.  Otherwise these are all NULL or 0.  */
+  const gdb_byte *file_contents = nullptr;
+  bfd_size_type file_contents_size = 0;
+  void *file_map_addr = nullptr;
+  bfd_size_type file_map_len = 0;
+
   /* If the BFD comes from an archive, this points to the archive's
      BFD.  Otherwise, this is NULL.  */
   bfd *archive_bfd = nullptr;
@@ -145,6 +167,18 @@ show_bfd_sharing  (struct ui_file *file, int from_tty,
   fprintf_filtered (file, _("BFD sharing is %s.\n"), value);
 }
 
+/* When true gdb_bfd_map_section serves uncompressed sections from a
+   single mapping of the whole file, rather than mapping or reading
+   each section on its own.  */
+
+static int bfd_map_whole_file = 1;
+static void
+show_bfd_map_whole_file (struct ui_file *file, int from_tty,
+			 struct cmd_list_element *c, const char *value)
+{
+  fprintf_filtered (file, _("Mapping whole BFD files is %s.\n"), value);
+}
+
 /* When non-zero debugging of the bfd caches is enabled.  */
 
 static unsigned int debug_bfd_cache;
@@ -482,7 +516,8 @@ free_one_bfd_section (bfd *abfd, asection *sectp, void *ignore)
   struct gdb_bfd_section_data *sect
     = (struct gdb_bfd_section_data *) bfd_get_section_userdata (abfd, sectp);
 
-  if (sect != NULL && sect->data != NULL)
+  /* Data in the whole-file map is released along with the map.  */
+  if (sect != NULL && sect->data != NULL && !sect->in_file_map)
     {
 #ifdef HAVE_MMAP
       if (sect->map_addr != NULL)
@@ -639,6 +674,51 @@ get_section_descriptor (asection *section)
   return result;
 }
 
+#ifdef HAVE_MMAP
+
+/* Return the contents of ABFD's file, mapping the whole file the first
+   time this is called for ABFD.  Return NULL if the file cannot be
+   mapped, for instance because it does not live on the host.  */
+
+static const gdb_byte *
+get_file_map (bfd *abfd)
+{
+  struct gdb_bfd_data *gdata = (struct gdb_bfd_data *) bfd_usrdata (abfd);
+
+  if (gdata == NULL)
+    return NULL;
+
+  if (!gdata->file_map_computed)
+    {
+      ufile_ptr file_size;
+
+      gdata->file_map_computed = 1;
+
+      file_size = bfd_get_file_size (abfd);
+      if (file_size > 0 && (abfd->flags & BFD_IN_MEMORY) == 0)
+	{
+	  void *data = bfd_mmap (abfd, 0, file_size, PROT_READ, MAP_PRIVATE,
+				 0, &gdata->file_map_addr,
+				 &gdata->file_map_len);
+
+	  if (data != MAP_FAILED)
+	    {
+	      gdata->file_contents = (const gdb_byte *) data;
+	      gdata->file_contents_size = file_size;
+	    }
+	  else
+	    {
+	      gdata->file_map_addr = NULL;
+	      gdata->file_map_len = 0;
+	    }
+	}
+    }
+
+  return gdata->file_contents;
+}
+
+#endif /* HAVE_MMAP */
+
 /* See gdb_bfd.h.  */
 
 const gdb_byte *
@@ -668,6 +748,30 @@ gdb_bfd_map_section (asection *sectp, bfd_size_type *size)
       if (pagesize == 0)
 	pagesize = getpagesize ();
 
+      /* Serve the section straight from the mapping of the whole file
+	 if we can.  This avoids copying small sections, and mapping
+	 each large one separately.  No readahead is requested for the
+	 map as a whole; see gdb_bfd_section_willneed.  */
+      if (bfd_map_whole_file
+	  && (sectp->flags & SEC_HAS_CONTENTS) != 0
+	  && sectp->filepos >= 0)
+	{
+	  const gdb_byte *contents = get_file_map (abfd);
+	  struct gdb_bfd_data *gdata
+	    = (struct gdb_bfd_data *) bfd_usrdata (abfd);
+	  bfd_size_type sect_size = bfd_get_section_size (sectp);
+
+	  if (contents != NULL
+	      && sectp->filepos <= gdata->file_contents_size
+	      && sect_size <= gdata->file_contents_size - sectp->filepos)
+	    {
+	      descriptor->size = sect_size;
+	      descriptor->data = (void *) (contents + sectp->filepos);
+	      descriptor->in_file_map = 1;
+	      goto done;
+	    }
+	}
+
       /* Only try to mmap sections which are large enough: we don't want
 	 to waste space due to fragmentation.  */
 
@@ -719,6 +823,61 @@ gdb_bfd_map_section (asection *sectp, bfd_size_type *size)
   return (const gdb_byte *) descriptor->data;
 }
 
+/* See gdb_bfd.h.  */
+
+void
+gdb_bfd_section_willneed (asection *sectp, bfd_size_type offset,
+			  bfd_size_type len)
+{
+#if defined (HAVE_MMAP) && defined (HAVE_POSIX_MADVISE)
+  struct gdb_bfd_section_data *descriptor
+    = ((struct gdb_bfd_section_data *)
+       bfd_get_section_userdata (sectp->owner, sectp));
+
+  /* Only mapped data can be paged in ahead of time.  */
+  if (descriptor == NULL
+      || descriptor->data == NULL
+      || (descriptor->map_addr == NULL && !descriptor->in_file_map)
+      || offset >= descriptor->size)
+    return;
+
+  if (len > descriptor->size - offset)
+    len = descriptor->size - offset;
+
+  uintptr_t pagesize_m1 = getpagesize () - 1;
+  uintptr_t start = (uintptr_t) descriptor->data + offset;
+  uintptr_t page_start = start & ~pagesize_m1;
+
+  posix_madvise ((void *) page_start, start + len - page_start,
+		 POSIX_MADV_WILLNEED);
+#endif
+}
+
+/* See gdb_bfd.h.  */
+
+const gdb_byte *
+gdb_bfd_map_file (bfd *abfd, bfd_size_type *size)
+{
+#ifdef HAVE_MMAP
+  if (bfd_map_whole_file)
+    {
+      const gdb_byte *contents = get_file_map (abfd);
+
+      if (contents != NULL)
+	{
+	  struct gdb_bfd_data *gdata
+	    = (struct gdb_bfd_data *) bfd_usrdata (abfd);
+
+	  *size = gdata->file_contents_size;
+	  return contents;
+	}
+    }
+#endif
+
+  *size = 0;
+  return NULL;
+}
+
 /* Return 32-bit CRC for ABFD.  If successful store it to *FILE_CRC_RETURN and
    return 1.  Otherwise print a warning and return 0.  ABFD seek position is
    not preserved.  */
@@ -986,6 +1145,18 @@ filename, file size, file modification time, and file inode."),
 			   &maintenance_set_cmdlist,
 			   &maintenance_show_cmdlist);
 
+  add_setshow_boolean_cmd ("bfd-map-whole-file", no_class,
+			   &bfd_map_whole_file, _("\
+Set whether gdb maps whole files to read section contents."), _("\
+Show whether gdb maps whole files to read section contents."), _("\
+When enabled gdb maps each file once, and reads the contents of its\n\
+uncompressed sections without relocations straight from that mapping,\n\
+instead of reading or mapping each section separately."),
+			   NULL,
+			   &show_bfd_map_whole_file,
+			   &maintenance_set_cmdlist,
+			   &maintenance_show_cmdlist);
+
   add_setshow_zuinteger_cmd ("bfd-cache", class_maintenance,
 			     &debug_bfd_cache, _("\
 Set bfd cache debugging."), _("\
@@ -115,6 +115,21 @@ void gdb_bfd_record_inclusion (bfd *includer, bfd *includee);
 
 const gdb_byte *gdb_bfd_map_section (asection *section, bfd_size_type *size);
 
+/* Advise the host that the LEN bytes at OFFSET in the contents of
+   SECTION, as returned by gdb_bfd_map_section, will be needed soon.
+   This does nothing unless the contents are mapped from the file.  */
+
+void gdb_bfd_section_willneed (asection *section, bfd_size_type offset,
+			       bfd_size_type len);
+
+/* Return the contents of the whole file ABFD was opened from, mapping
+   it the first time this is called, and set *SIZE to its size.  The
+   mapping is associated with the BFD and is destroyed with it.  Return
+   NULL if the file cannot be mapped, for instance because it does not
+   live on the host, or if mapping whole files is disabled.  */
+
+const gdb_byte *gdb_bfd_map_file (bfd *abfd, bfd_size_type *size);
+
 /* Compute the CRC for ABFD.  The CRC is used to find and verify
    separate debug files.  When successful, this fills in *CRC_OUT and
    returns 1.  Otherwise, this issues a warning and returns 0.  */
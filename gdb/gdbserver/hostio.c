@@ -347,7 +347,8 @@ handle_open (char *own_buf)
 static void
 handle_pread (char *own_buf, int *new_packet_len)
 {
-  int fd, ret, len, offset, bytes_sent;
+  client_state &cs = get_client_state ();
+  int fd, ret, len, offset, bytes_sent, header_len, zlen, consumed;
   char *p, *data;
   static int max_reply_size = -1;
 
@@ -373,8 +374,8 @@ handle_pread (char *own_buf, int *new_packet_len)
       sprintf (own_buf, "F%x;", PBUFSIZ);
       max_reply_size = PBUFSIZ - strlen (own_buf);
     }
-  if (len > max_reply_size)
-    len = max_reply_size;
+  if (len > (cs.zlib_transfers ? MAX_COMPRESSED_TRANSFER : max_reply_size))
+    len = cs.zlib_transfers ? MAX_COMPRESSED_TRANSFER : max_reply_size;
 
   data = (char *) xmalloc (len);
 #ifdef HAVE_PREAD
@@ -397,6 +398,34 @@ handle_pread (char *own_buf, int *new_packet_len)
       return;
     }
 
+  /* With zlib transfers, a reply whose attachment is shorter than the
+     count it reports is a zlib stream.  It holds as much of the data
+     as compresses to fit in a packet, and the count says how much
+     that is.  Data that does not compress is sent plain, cut down to
+     fit in a packet.  */
+  sprintf (own_buf, "F%x;", ret);
+  header_len = strlen (own_buf);
+  zlen = write_compressed_data ((const gdb_byte *) data, ret,
+				own_buf + header_len, PBUFSIZ - header_len,
+				&consumed);
+  if (zlen >= 0)
+    {
+      char header[20];
+      int consumed_header_len;
+
+      /* CONSUMED has no more digits than RET, so the header can only
+	 shrink.  */
+      consumed_header_len = xsnprintf (header, sizeof (header), "F%x;",
+				       consumed);
+      memmove (own_buf + consumed_header_len, own_buf + header_len, zlen);
+      memcpy (own_buf, header, consumed_header_len);
+      *new_packet_len = consumed_header_len + zlen;
+      free (data);
+      return;
+    }
+  if (ret > max_reply_size)
+    ret = max_reply_size;
+
   bytes_sent = hostio_reply_with_data (own_buf, data, ret, new_packet_len);
 
   /* If we were using read, and the data did not all fit in the reply,
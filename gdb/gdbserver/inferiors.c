@@ -21,10 +21,16 @@
 #include "server.h"
 #include "gdbthread.h"
 #include "dll.h"
+#include <unordered_map>
 
 std::list<process_info *> all_processes;
 std::list<thread_info *> all_threads;
 
+/* All threads, indexed by ptid, so that mapping an event back to its
+   thread doesn't need to walk ALL_THREADS.  If several threads have
+   the same ptid, this holds the first one in ALL_THREADS.  */
+static std::unordered_map<ptid_t, thread_info *, hash_ptid> thread_ptid_map;
+
 struct thread_info *current_thread;
 
 /* The current working directory used to start the inferior.  */
@@ -40,6 +46,7 @@ add_thread (ptid_t thread_id, void *target_data)
   new_thread->last_status.kind = TARGET_WAITKIND_IGNORE;
 
   all_threads.push_back (new_thread);
+  thread_ptid_map.emplace (thread_id, new_thread);
 
   if (current_thread == NULL)
     current_thread = new_thread;
@@ -63,9 +70,12 @@ get_first_thread (void)
 struct thread_info *
 find_thread_ptid (ptid_t ptid)
 {
-  return find_thread ([&] (thread_info *thread) {
-    return thread->id == ptid;
-  });
+  auto it = thread_ptid_map.find (ptid);
+
+  if (it == thread_ptid_map.end ())
+    return NULL;
+
+  return it->second;
 }
 
 /* Find a thread associated with the given PROCESS, or NULL if no
@@ -102,6 +112,21 @@ remove_thread (struct thread_info *thread)
 
   discard_queued_stop_replies (ptid_of (thread));
   all_threads.remove (thread);
+
+  auto it = thread_ptid_map.find (thread->id);
+  if (it != thread_ptid_map.end () && it->second == thread)
+    {
+      /* Let another thread with the same ptid, if any, take its
+	 place.  */
+      thread_info *other = find_thread ([&] (thread_info *thr_arg) {
+	return thr_arg->id == thread->id;
+      });
+
+      if (other != NULL)
+	it->second = other;
+      else
+	thread_ptid_map.erase (it);
+    }
   free_one_thread (thread);
   if (current_thread == thread)
     current_thread = NULL;
@@ -130,6 +155,7 @@ clear_inferiors (void)
 {
   for_each_thread (free_one_thread);
   all_threads.clear ();
+  thread_ptid_map.clear ();
 
   clear_dlls ();
 
@@ -29,6 +29,7 @@
 #include "nat/gdb_ptrace.h"
 #include "nat/linux-ptrace.h"
 #include "nat/linux-procfs.h"
+#include "nat/linux-proc-mem.h"
 #include "nat/linux-personality.h"
 #include <signal.h>
 #include <sys/ioctl.h>
@@ -51,6 +52,7 @@
 #include "nat/fork-inferior.h"
 #include "common/environ.h"
 #include "common/scoped_restore.h"
+#include <unordered_map>
 #ifndef ELFMAG0
 /* Don't include <linux/elf.h> here.  If it got included by gdb_proc_service.h
    then ELFMAG0 will have been defined.  If it didn't get included by
@@ -410,6 +412,12 @@ linux_pid_exe_is_elf_64_file (int pid, unsigned int *machine)
   return elf_64_file_p (file, machine);
 }
 
+/* All known LWPs, indexed by LWP id.  Every status that comes out of
+   waitpid is mapped back to its LWP, so with many LWPs, walking the
+   thread list for each of them would make stopping all threads
+   quadratic.  */
+static std::unordered_map<long, lwp_info *> lwp_lwpid_map;
+
 static void
 delete_lwp (struct lwp_info *lwp)
 {
@@ -418,6 +426,7 @@ delete_lwp (struct lwp_info *lwp)
   if (debug_threads)
     debug_printf ("deleting %ld\n", lwpid_of (thr));
 
+  lwp_lwpid_map.erase (lwpid_of (thr));
   remove_thread (thr);
 
   if (the_low_target.delete_thread != NULL)
@@ -956,6 +965,7 @@ add_lwp (ptid_t ptid)
   lwp->waitstatus.kind = TARGET_WAITKIND_IGNORE;
 
   lwp->thread = add_thread (ptid, lwp);
+  lwp_lwpid_map[lwpid_of (lwp->thread)] = lwp;
 
   if (the_low_target.new_thread != NULL)
     the_low_target.new_thread (lwp);
@@ -1661,6 +1671,8 @@ linux_mourn (struct process_info *process)
       delete_lwp (get_thread_lwp (thread));
     });
 
+  linux_proc_mem_close (process->pid);
+
   /* Freeing all private data.  */
   priv = process->priv;
   if (the_low_target.delete_process != NULL)
@@ -1815,16 +1827,13 @@ status_pending_p_callback (thread_info *thread, ptid_t ptid)
 struct lwp_info *
 find_lwp_pid (ptid_t ptid)
 {
-  thread_info *thread = find_thread ([&] (thread_info *thr_arg)
-    {
-      int lwp = ptid.lwp () != 0 ? ptid.lwp () : ptid.pid ();
-      return thr_arg->id.lwp () == lwp;
-    });
+  long lwp = ptid.lwp () != 0 ? ptid.lwp () : ptid.pid ();
+  auto it = lwp_lwpid_map.find (lwp);
 
-  if (thread == NULL)
+  if (it == lwp_lwpid_map.end ())
     return NULL;
 
-  return get_thread_lwp (thread);
+  return it->second;
 }
 
 /* Return the number of known LWPs in the tgid given by PID.  */
@@ -2744,11 +2753,14 @@ linux_wait_for_event_filtered (ptid_t wait_ptid, ptid_t filter_ptid,
 	for_each_thread (resume_stopped_resumed_lwps);
 
       /* ... and find an LWP with a status to report to the core, if
-	 any.  */
-      event_thread = find_thread_in_random ([&] (thread_info *thread)
-	{
-	  return status_pending_p_callback (thread, filter_ptid);
-	});
+	 any.  When called from wait_for_sigstop, FILTER_PTID is null and
+	 all events are left pending; skip walking all threads after
+	 each batch of events in that case.  */
+      if (filter_ptid != null_ptid)
+	event_thread = find_thread_in_random ([&] (thread_info *thread)
+	  {
+	    return status_pending_p_callback (thread, filter_ptid);
+	  });
 
       if (event_thread != NULL)
 	{
@@ -5722,36 +5734,16 @@ linux_read_memory (CORE_ADDR memaddr, unsigned char *myaddr, int len)
   PTRACE_XFER_TYPE *buffer;
   CORE_ADDR addr;
   int count;
-  char filename[64];
   int i;
   int ret;
-  int fd;
 
-  /* Try using /proc.  Don't bother for one word.  */
-  if (len >= 3 * sizeof (long))
+  /* Try the process's cached /proc/PID/mem file first.  It transfers
+     any amount of memory in one syscall, so it is cheaper than ptrace
+     even for a single word.  */
+  if (len > 0)
     {
-      int bytes;
-
-      /* We could keep this file open and cache it - possibly one per
-	 thread.  That requires some juggling, but is even faster.  */
-      sprintf (filename, "/proc/%d/mem", pid);
-      fd = open (filename, O_RDONLY | O_LARGEFILE);
-      if (fd == -1)
-	goto no_proc;
-
-      /* If pread64 is available, use it.  It's faster if the kernel
-	 supports it (only one syscall), and it's 64-bit safe even on
-	 32-bit platforms (for instance, SPARC debugging a SPARC64
-	 application).  */
-#ifdef HAVE_PREAD64
-      bytes = pread64 (fd, myaddr, len, memaddr);
-#else
-      bytes = -1;
-      if (lseek (fd, memaddr, SEEK_SET) != -1)
-	bytes = read (fd, myaddr, len);
-#endif
-
-      close (fd);
+      LONGEST bytes = linux_proc_mem_xfer (pid_of (current_thread), pid,
+					   myaddr, NULL, memaddr, len);
       if (bytes == len)
 	return 0;
 
@@ -5764,7 +5756,6 @@ linux_read_memory (CORE_ADDR memaddr, unsigned char *myaddr, int len)
 	}
     }
 
- no_proc:
   /* Round starting address down to longword boundary.  */
   addr = memaddr & -(CORE_ADDR) sizeof (PTRACE_XFER_TYPE);
   /* Round ending address up; get number of longwords that makes.  */
@@ -5844,6 +5835,10 @@ linux_write_memory (CORE_ADDR memaddr, const unsigned char *myaddr, int len)
 		    str, (long) memaddr, pid);
     }
 
+  if (linux_proc_mem_xfer (pid_of (current_thread), pid, NULL, myaddr,
+			   memaddr, len) == len)
+    return 0;
+
   /* Fill start and end extra bytes of buffer with existing memory data.  */
 
   errno = 0;
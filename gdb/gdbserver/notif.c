@@ -43,7 +43,10 @@
    Once GDB has a chance to ack to FOO, it sends an ack to GDBserver,
    and GDBserver repeatedly sends events to GDB and gets ack of FOO,
    until queue is empty.  Then, GDBserver sends 'OK' to GDB that all
-   queued notification events are done.
+   queued notification events are done.  If GDB supports the
+   "vStopped-batch" feature, each reply carries as many queued events
+   as fit in the packet, separated by '|', and a single ack from GDB
+   acknowledges all of them.
 
    # 3 is done by function 'handle_notif_ack'.  */
 
@@ -67,6 +70,63 @@ notif_write_event (struct notif_server *notif, char *own_buf)
 	= QUEUE_peek (notif_event_p, notif->queue);
 
       notif->write (event, own_buf);
+      event->sent = 1;
+    }
+  else
+    write_ok (own_buf);
+}
+
+/* Data passed to notif_write_batch_1.  */
+
+struct notif_write_batch_data
+{
+  struct notif_server *notif;
+  char *own_buf;
+  char *p;
+};
+
+/* QUEUE_iterate callback for notif_write_batch.  Append EVENT to the
+   events already written, if there's room.  */
+
+static int
+notif_write_batch_1 (QUEUE (notif_event_p) *q,
+		     QUEUE_ITER (notif_event_p) *iter,
+		     struct notif_event *event,
+		     void *data)
+{
+  struct notif_write_batch_data *d = (struct notif_write_batch_data *) data;
+
+  if (d->p != d->own_buf)
+    {
+      /* Writing an event can't be undone (e.g., it releases an exec
+	 event's pathname), so only start another one if at least half
+	 of the buffer is left, which is more than a single event
+	 needs.  */
+      if (d->p - d->own_buf >= PBUFSIZ / 2)
+	return 0;
+
+      *d->p++ = '|';
+    }
+
+  d->notif->write (event, d->p);
+  d->p += strlen (d->p);
+  event->sent = 1;
+
+  return 1;
+}
+
+/* Like notif_write_event, but write as many of the queued events as
+   fit in OWN_BUF, separated by '|'.  */
+
+static void
+notif_write_batch (struct notif_server *notif, char *own_buf)
+{
+  if (!QUEUE_is_empty (notif_event_p, notif->queue))
+    {
+      struct notif_write_batch_data data = { notif, own_buf, own_buf };
+
+      QUEUE_iterate (notif_event_p, notif->queue, notif_write_batch_1,
+		     &data);
     }
   else
     write_ok (own_buf);
@@ -96,9 +156,11 @@ handle_notif_ack (char *own_buf, int packet_len)
 
   np = notifs[i];
 
-  /* If we're waiting for GDB to acknowledge a pending event,
-     consider that done.  */
-  if (!QUEUE_is_empty (notif_event_p, np->queue))
+  /* If we're waiting for GDB to acknowledge pending events, consider
+     that done.  The events we sent are always at the head of the
+     queue.  */
+  while (!QUEUE_is_empty (notif_event_p, np->queue)
+	 && QUEUE_peek (notif_event_p, np->queue)->sent)
     {
       struct notif_event *head
 	= QUEUE_deque (notif_event_p, np->queue);
@@ -110,7 +172,10 @@ handle_notif_ack (char *own_buf, int packet_len)
       xfree (head);
     }
 
-  notif_write_event (np, own_buf);
+  if (get_client_state ().vstopped_batch)
+    notif_write_batch (np, own_buf);
+  else
+    notif_write_event (np, own_buf);
 
   return 1;
 }
@@ -121,6 +186,7 @@ void
 notif_event_enque (struct notif_server *notif,
 		   struct notif_event *event)
 {
+  event->sent = 0;
   QUEUE_enque (notif_event_p, notif->queue, event);
 
   if (remote_debug)
@@ -150,6 +216,7 @@ notif_push (struct notif_server *np, struct notif_event *new_event)
       p += strlen (p);
 
       np->write (new_event, p);
+      new_event->sent = 1;
       putpkt_notif (buf);
     }
 }
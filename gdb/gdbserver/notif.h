@@ -28,8 +28,9 @@
 
 typedef struct notif_event
 {
-  /* C requires that a struct or union has at least one member.  */
-  char dummy;
+  /* Nonzero if this event was sent to GDB, which has not acknowledged
+     it yet.  */
+  int sent;
 } *notif_event_p;
 
 DECLARE_QUEUE_P (notif_event_p);
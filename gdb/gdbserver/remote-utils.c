@@ -27,6 +27,8 @@
 #include "common/rsp-low.h"
 #include "common/netstuff.h"
 #include "common/filestuff.h"
+#include "common/byte-vector.h"
+#include "common/scope-exit.h"
 #include <ctype.h>
 #if HAVE_SYS_IOCTL_H
 #include <sys/ioctl.h>
@@ -74,6 +76,10 @@
 #include <sys/iomgr.h>
 #endif /* __QNX__ */
 
+#ifdef HAVE_LIBZ
+#include <zlib.h>
+#endif
+
 #ifndef HAVE_SOCKLEN_T
 typedef int socklen_t;
 #endif
@@ -1130,11 +1136,64 @@ outreg (struct regcache *regcache, int regno, char *buf)
   return buf;
 }
 
+/* Write a "regs:THREAD-ID,REGISTERS;" stop reply field for each
+   thread of process PID, at BUF, stopping at the first thread whose
+   registers would not fit in the packet buffer that starts at
+   BUF_START.  Returns a pointer past the last field written.  */
+
+static char *
+write_thread_registers (char *buf, const char *buf_start, int pid)
+{
+  /* Keep room for the trailing fields of the stop reply.  */
+  const char *buf_end = buf_start + PBUFSIZ - 64;
+  bool full = false;
+
+  for_each_thread (pid, [&] (thread_info *thread)
+    {
+      if (full)
+	return;
+
+      struct regcache *regcache;
+
+      try
+	{
+	  regcache = get_thread_regcache (thread, 1);
+	}
+      catch (const gdb_exception_error &exception)
+	{
+	  /* The thread may have vanished; GDB will ask for its
+	     registers the usual way if it needs them.  */
+	  return;
+	}
+
+      size_t len = (strlen ("regs:") + 2 * sizeof (ULONGEST) * 2 + 4
+		    + 2 * register_cache_size (regcache->tdesc) + 1);
+      if (buf + len > buf_end)
+	{
+	  /* This and any further threads don't fit.  */
+	  full = true;
+	  return;
+	}
+
+      strcpy (buf, "regs:");
+      buf += strlen (buf);
+      buf = write_ptid (buf, ptid_of (thread));
+      *buf++ = ',';
+      registers_to_string (regcache, buf);
+      buf += strlen (buf);
+      strcpy (buf, ";");
+      buf += strlen (buf);
+    });
+
+  return buf;
+}
+
 void
 prepare_resume_reply (char *buf, ptid_t ptid,
 		      struct target_waitstatus *status)
 {
   client_state &cs = get_client_state ();
+  char *buf_start = buf;
   if (debug_threads)
     debug_printf ("Writing resume reply for %s:%d\n",
 		  target_pid_to_str (ptid), status->kind);
@@ -1299,6 +1358,16 @@ prepare_resume_reply (char *buf, ptid_t ptid,
 		    buf += strlen (buf);
 		  }
 	      }
+
+	    /* In all-stop mode every thread of the process is stopped
+	       now, and GDB is likely to read the registers of all of
+	       them (e.g., to check for breakpoint hits, or for "thread
+	       apply all bt").  Send the whole register block of each
+	       thread that fits, to save GDB a 'g' round trip per
+	       thread.  */
+	    if (cs.expedite_all_registers && !non_stop
+		&& status->kind == TARGET_WAITKIND_STOPPED)
+	      buf = write_thread_registers (buf, buf_start, ptid.pid ());
 	  }
 
 	if (dlls_changed)
@@ -1417,6 +1486,113 @@ decode_X_packet (char *from, int packet_len, CORE_ADDR *mem_addr_ptr,
   return 0;
 }
 
+/* Compress as much of the LEN bytes at DATA as fits in BUF_SIZE
+   bytes into a zlib stream, escaped as binary packet data, and store
+   it in BUF.  Store in *CONSUMED the number of bytes of DATA the
+   stream holds, and return the length stored in BUF.  Return -1 if
+   zlib transfers are off, or if sending the data plain would be as
+   good: the stream must hold either more bytes than BUF_SIZE, or all
+   of DATA in fewer bytes.  */
+
+int
+write_compressed_data (const gdb_byte *data, int len, char *buf,
+		       int buf_size, int *consumed)
+{
+#ifdef HAVE_LIBZ
+  client_state &cs = get_client_state ();
+
+  /* Small transfers are not worth the trouble.  */
+  if (!cs.zlib_transfers || len < 256)
+    return -1;
+
+  /* Deflate the data a chunk at a time, flushing the stream to a byte
+     boundary after each chunk, and stop once the output buffer is
+     full.  That way, data that compresses badly costs about one
+     packet's worth of deflating.  The stream can end at any such sync
+     point, with an empty final block and the checksum of the data up
+     to there; use the last one whose escaped stream fits.  */
+  const int chunk_size = 4096;
+  /* The empty final block, and the Adler-32 checksum.  */
+  const int trailer_size = 6;
+
+  struct sync_point
+  {
+    /* The number of bytes of DATA, and of the stream, up to here.  */
+    int in, out;
+
+    /* The checksum of those bytes of DATA.  */
+    uLong adler;
+  };
+
+  if (buf_size <= trailer_size)
+    return -1;
+
+  z_stream strm;
+  memset (&strm, 0, sizeof (strm));
+  if (deflateInit (&strm, Z_DEFAULT_COMPRESSION) != Z_OK)
+    return -1;
+  SCOPE_EXIT { deflateEnd (&strm); };
+
+  gdb::byte_vector zdata (buf_size);
+  std::vector<sync_point> points;
+  uLong adler = adler32 (0, Z_NULL, 0);
+  int in = 0;
+
+  strm.next_out = zdata.data ();
+  strm.avail_out = buf_size - trailer_size;
+  while (in < len)
+    {
+      int n = std::min (chunk_size, len - in);
+
+      strm.next_in = (Bytef *) data + in;
+      strm.avail_in = n;
+      if (deflate (&strm, Z_SYNC_FLUSH) != Z_OK
+	  || strm.avail_in != 0 || strm.avail_out == 0)
+	break;
+
+      adler = adler32 (adler, data + in, n);
+      in += n;
+      points.push_back ({in, (int) strm.total_out, adler});
+    }
+
+  for (auto it = points.rbegin (); it != points.rend (); ++it)
+    {
+      gdb_byte *end = zdata.data () + it->out;
+      int zlen = it->out + trailer_size;
+
+      /* Byte-aligned after the flush, so the empty final block with
+	 fixed codes is always the same two bytes.  The checksum is
+	 big-endian.  */
+      end[0] = 0x03;
+      end[1] = 0x00;
+      end[2] = it->adler >> 24;
+      end[3] = it->adler >> 16;
+      end[4] = it->adler >> 8;
+      end[5] = it->adler;
+
+      int out_len;
+      int escaped_len = remote_escape_output (zdata.data (), zlen, 1,
+					      (gdb_byte *) buf, &out_len,
+					      buf_size);
+      if (out_len != zlen)
+	continue;
+
+      if (it->in > buf_size || (it->in == len && escaped_len < len))
+	{
+	  *consumed = it->in;
+	  return escaped_len;
+	}
+
+      /* Earlier sync points hold even less data.  */
+      break;
+    }
+
+  return -1;
+#else
+  return -1;
+#endif
+}
+
 /* Decode a qXfer write request.  */
 
 int
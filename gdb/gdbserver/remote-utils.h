@@ -56,6 +56,8 @@ int decode_X_packet (char *from, int packet_len, CORE_ADDR * mem_addr_ptr,
 int decode_xfer_write (char *buf, int packet_len,
 		       CORE_ADDR *offset, unsigned int *len,
 		       unsigned char *data);
+int write_compressed_data (const gdb_byte *data, int len, char *buf,
+			   int buf_size, int *consumed);
 int decode_search_memory_packet (const char *buf, int packet_len,
 				 CORE_ADDR *start_addrp,
 				 CORE_ADDR *search_space_lenp,
@@ -1192,6 +1192,60 @@ handle_search_memory (char *own_buf, int packet_len)
   free (pattern);
 }
 
+/* Handle a "qMemRead:" packet: a ';'-separated list of ADDR,LENGTH
+   memory ranges, read in order.  The reply holds one result per
+   range, separated by ';': the contents in hex, which may be shorter
+   than asked for if the reply would not fit otherwise, or "E01" if
+   the range could not be read.  */
+
+static void
+handle_memory_read_ranges (char *own_buf)
+{
+  const char *p = own_buf + strlen ("qMemRead:");
+  std::string reply;
+  bool first = true;
+
+  while (*p != '\0')
+    {
+      ULONGEST addr, len;
+
+      p = unpack_varlen_hex (p, &addr);
+      if (*p != ',')
+	{
+	  write_enn (own_buf);
+	  return;
+	}
+      p = unpack_varlen_hex (p + 1, &len);
+      if (*p == ';')
+	p++;
+      else if (*p != '\0')
+	{
+	  write_enn (own_buf);
+	  return;
+	}
+
+      /* Leave room for the separator, and for an error reply.  */
+      if (reply.size () + 4 >= PBUFSIZ)
+	{
+	  write_enn (own_buf);
+	  return;
+	}
+      len = std::min (len, (ULONGEST) (PBUFSIZ - reply.size () - 2) / 2);
+
+      if (!first)
+	reply += ';';
+      first = false;
+
+      int res = gdb_read_memory (addr, mem_buf, len);
+      if (res < 0)
+	reply += "E01";
+      else
+	reply += bin2hex (mem_buf, res);
+    }
+
+  strcpy (own_buf, reply.c_str ());
+}
+
 /* Handle the "D" packet.  */
 
 static void
@@ -2023,9 +2077,12 @@ handle_qxfer (char *own_buf, int packet_len, int *new_packet_len_p)
 	  if (strcmp (rw, "read") == 0)
 	    {
 	      unsigned char *data;
-	      int n;
+	      int n, is_more, zlen, consumed;
 	      CORE_ADDR ofs;
 	      unsigned int len;
+	      unsigned int max_len = (get_client_state ().zlib_transfers
+				      ? MAX_COMPRESSED_TRANSFER
+				      : PBUFSIZ - 2);
 
 	      /* Grab the offset and length.  */
 	      if (decode_xfer_read (offset, &ofs, &len) < 0)
@@ -2035,9 +2092,11 @@ handle_qxfer (char *own_buf, int packet_len, int *new_packet_len_p)
 		}
 
 	      /* Read one extra byte, as an indicator of whether there is
-		 more.  */
-	      if (len > PBUFSIZ - 2)
-		len = PBUFSIZ - 2;
+		 more.  With zlib transfers, read as much as a compressed
+		 reply may hold; if the data does not compress well
+		 enough, less of it is sent plain below.  */
+	      if (len > max_len)
+		len = max_len;
 	      data = (unsigned char *) malloc (len + 1);
 	      if (data == NULL)
 		{
@@ -2056,10 +2115,30 @@ handle_qxfer (char *own_buf, int packet_len, int *new_packet_len_p)
 		}
 	      else if (n < 0)
 		write_enn (own_buf);
-	      else if (n > len)
-		*new_packet_len_p = write_qxfer_response (own_buf, data, len, 1);
 	      else
-		*new_packet_len_p = write_qxfer_response (own_buf, data, n, 0);
+		{
+		  is_more = n > len;
+		  if (is_more)
+		    n = len;
+
+		  /* A compressed reply may hold only part of the data,
+		     as much as fits in a packet; GDB then asks for the
+		     rest at the offset after it.  */
+		  zlen = write_compressed_data (data, n, own_buf + 2,
+						PBUFSIZ - 3, &consumed);
+		  if (zlen >= 0)
+		    {
+		      own_buf[0] = 'z';
+		      own_buf[1] = is_more || consumed < n ? 'm' : 'l';
+		      *new_packet_len_p = zlen + 2;
+		    }
+		  else if (n > PBUFSIZ - 2)
+		    *new_packet_len_p = write_qxfer_response (own_buf, data,
+							      PBUFSIZ - 2, 1);
+		  else
+		    *new_packet_len_p = write_qxfer_response (own_buf, data,
+							      n, is_more);
+		}
 
 	      free (data);
 	      return 1;
@@ -2358,6 +2437,25 @@ handle_query (char *own_buf, int packet_len, int *new_packet_len_p)
 		     events.  */
 		  report_no_resumed = 1;
 		}
+	      else if (strcmp (p, "zlib-transfers+") == 0)
+		{
+		  /* GDB can inflate compressed qXfer and vFile:pread
+		     data.  */
+#ifdef HAVE_LIBZ
+		  cs.zlib_transfers = 1;
+#endif
+		}
+	      else if (strcmp (p, "expedite-all-registers+") == 0)
+		{
+		  /* GDB understands "regs" stop reply fields.  */
+		  cs.expedite_all_registers = 1;
+		}
+	      else if (strcmp (p, "vStopped-batch+") == 0)
+		{
+		  /* GDB accepts several stop replies in one reply to
+		     vStopped.  */
+		  cs.vstopped_batch = 1;
+		}
 	      else
 		{
 		  /* Move the unknown features all together.  */
@@ -2484,6 +2582,17 @@ handle_query (char *own_buf, int packet_len, int *new_packet_len_p)
 
       strcat (own_buf, ";no-resumed+");
 
+      strcat (own_buf, ";qMemRead+");
+
+      if (cs.zlib_transfers)
+	strcat (own_buf, ";zlib-transfers+");
+
+      if (cs.expedite_all_registers)
+	strcat (own_buf, ";expedite-all-registers+");
+
+      if (cs.vstopped_batch)
+	strcat (own_buf, ";vStopped-batch+");
+
       /* Reinitialize components as needed for the new connection.  */
       hostio_handle_new_gdb_connection ();
       target_handle_new_gdb_connection ();
@@ -2618,6 +2727,13 @@ handle_query (char *own_buf, int packet_len, int *new_packet_len_p)
       return;
     }
 
+  if (startswith (own_buf, "qMemRead:"))
+    {
+      require_running_or_return (own_buf);
+      handle_memory_read_ranges (own_buf);
+      return;
+    }
+
   if (strcmp (own_buf, "qAttached") == 0
       || startswith (own_buf, "qAttached:"))
     {
@@ -3104,6 +3220,8 @@ handle_v_kill (char *own_buf)
     }
 }
 
+static void handle_v_point_list (char *own_buf);
+
 /* Handle all of the extended 'v' packets.  */
 void
 handle_v_requests (char *own_buf, int packet_len, int *new_packet_len)
@@ -3190,6 +3308,17 @@ handle_v_requests (char *own_buf, int packet_len, int *new_packet_len)
       return;
     }
 
+  if (startswith (own_buf, "vZ;"))
+    {
+      if (!target_running ())
+	{
+	  write_enn (own_buf);
+	  return;
+	}
+      handle_v_point_list (own_buf);
+      return;
+    }
+
   if (handle_notif_ack (own_buf, packet_len))
     return;
 
@@ -3859,6 +3988,9 @@ captured_main (int argc, char *argv[])
       cs.swbreak_feature = 0;
       cs.hwbreak_feature = 0;
       cs.vCont_supported = 0;
+      cs.zlib_transfers = 0;
+      cs.expedite_all_registers = 0;
+      cs.vstopped_batch = 0;
 
       remote_open (port);
 
@@ -4020,6 +4152,84 @@ process_point_options (struct gdb_breakpoint *bp, const char **packet)
   *packet = dataptr;
 }
 
+/* Insert or remove the *point described by PACKET, a 'Z' or 'z'
+   packet with any trailing breakpoint options.  Returns 0 on success,
+   1 if the *point type is not supported, and -1 on error.  */
+
+static int
+process_point_packet (const char *packet)
+{
+  char *dataptr;
+  ULONGEST addr;
+  int kind;
+  char type = packet[1];
+  int res;
+  const int insert = packet[0] == 'Z';
+  const char *p = &packet[3];
+
+  p = unpack_varlen_hex (p, &addr);
+  kind = strtol (p + 1, &dataptr, 16);
+
+  if (insert)
+    {
+      struct gdb_breakpoint *bp;
+
+      bp = set_gdb_breakpoint (type, addr, kind, &res);
+      if (bp != NULL)
+	{
+	  res = 0;
+
+	  /* GDB may have sent us a list of *point parameters to be
+	     evaluated on the target's side.  Read such list here.  If
+	     we already have a list of parameters, GDB is telling us to
+	     drop that list and use this one instead.  */
+	  clear_breakpoint_conditions_and_commands (bp);
+	  const char *options = dataptr;
+	  process_point_options (bp, &options);
+	}
+    }
+  else
+    res = delete_gdb_breakpoint (type, addr, kind);
+
+  return res;
+}
+
+/* Handle a "vZ;" packet: a '|'-separated list of 'Z' and 'z'
+   packets, processed in order.  The reply holds one result per
+   entry, separated by ';': "OK", or "E01" if that entry failed or
+   asked for an unsupported *point type.  */
+
+static void
+handle_v_point_list (char *own_buf)
+{
+  std::string packets (own_buf + strlen ("vZ;"));
+  std::string reply;
+  size_t start = 0;
+
+  while (true)
+    {
+      size_t end = packets.find ('|', start);
+      std::string entry
+	= packets.substr (start, end == std::string::npos
+				 ? std::string::npos : end - start);
+
+      if (!reply.empty ())
+	reply += ';';
+
+      if (entry.size () >= 3 && (entry[0] == 'Z' || entry[0] == 'z')
+	  && process_point_packet (entry.c_str ()) == 0)
+	reply += "OK";
+      else
+	reply += "E01";
+
+      if (end == std::string::npos)
+	break;
+      start = end + 1;
+    }
+
+  strcpy (own_buf, reply.c_str ());
+}
+
 /* Event loop callback that handles a serial event.  The first byte in
    the serial buffer gets us here.  We expect characters to arrive at
    a brisk pace, so we read the rest of the packet with a blocking
@@ -4233,38 +4443,7 @@ process_serial_event (void)
       /* Fallthrough.  */
     case 'z':  /* remove_ ... */
       {
-	char *dataptr;
-	ULONGEST addr;
-	int kind;
-	char type = cs.own_buf[1];
-	int res;
-	const int insert = ch == 'Z';
-	const char *p = &cs.own_buf[3];
-
-	p = unpack_varlen_hex (p, &addr);
-	kind = strtol (p + 1, &dataptr, 16);
-
-	if (insert)
-	  {
-	    struct gdb_breakpoint *bp;
-
-	    bp = set_gdb_breakpoint (type, addr, kind, &res);
-	    if (bp != NULL)
-	      {
-		res = 0;
-
-		/* GDB may have sent us a list of *point parameters to
-		   be evaluated on the target's side.  Read such list
-		   here.  If we already have a list of parameters, GDB
-		   is telling us to drop that list and use this one
-		   instead.  */
-		clear_breakpoint_conditions_and_commands (bp);
-		const char *options = dataptr;
-		process_point_options (bp, &options);
-	      }
-	  }
-	else
-	  res = delete_gdb_breakpoint (type, addr, kind);
+	int res = process_point_packet (cs.own_buf);
 
 	if (res == 0)
 	  write_ok (cs.own_buf);
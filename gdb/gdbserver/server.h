@@ -115,6 +115,10 @@ extern int in_queued_stop_replies (ptid_t ptid);
    as large as the largest register set supported by gdbserver.  */
 #define PBUFSIZ 18432
 
+/* The most data to send, compressed, in reply to a single qXfer read
+   or vFile:pread request when zlib transfers are on.  */
+#define MAX_COMPRESSED_TRANSFER (16 * PBUFSIZ)
+
 /* Definition for an unknown syscall, used basically in error-cases.  */
 #define UNKNOWN_SYSCALL (-1)
 
@@ -174,6 +178,21 @@ struct client_state
      "vCont?" packet.  */
   int vCont_supported = 0;
 
+  /* True if the "zlib-transfers" feature is active.  In that case, we
+     may send qXfer and vFile:pread data as zlib streams.  Only enabled
+     if gdbserver was built with zlib.  */
+  int zlib_transfers = 0;
+
+  /* True if the "expedite-all-registers" feature is active.  In that
+     case, all-stop stop replies carry the registers of every stopped
+     thread.  */
+  int expedite_all_registers = 0;
+
+  /* True if the "vStopped-batch" feature is active.  In that case, we
+     may send several queued stop replies in reply to one vStopped
+     packet.  */
+  int vstopped_batch = 0;
+
   /* Whether we should attempt to disable the operating system's address
      space randomization feature before starting an inferior.  */
   int disable_randomization = 1;
@@ -54,6 +54,7 @@ struct thread_info;
 #include "common/forward-scope-exit.h"
 
 #include "common/common-inferior.h"
+#include <unordered_map>
 #include "gdbthread.h"
 
 struct infcall_suspend_state;
@@ -355,6 +356,16 @@ public:
   /* This inferior's thread list.  */
   thread_info *thread_list = nullptr;
 
+  /* The last thread in THREAD_LIST, so that new threads can be
+     appended without walking the list.  */
+  thread_info *thread_list_tail = nullptr;
+
+  /* This inferior's threads, indexed by ptid, for find_thread_ptid.
+     If several threads in THREAD_LIST have the same ptid (e.g., an
+     exited thread that is still referenced, and a new thread that
+     reuses its ptid), this holds the first one in the list.  */
+  std::unordered_map<ptid_t, thread_info *, hash_ptid> ptid_thread_map;
+
   /* Returns a range adapter covering the inferior's threads,
      including exited threads.  Used like this:
 
@@ -31,6 +31,7 @@
 #include "source.h"
 
 #include "nat/gdb_ptrace.h"
+#include "nat/linux-proc-mem.h"
 #include "common/gdb_wait.h"
 #include <dirent.h>
 #include <ctype.h>
@@ -132,6 +133,7 @@ static void
 delete_fork (ptid_t ptid)
 {
   linux_target->low_forget_process (ptid.pid ());
+  linux_proc_mem_close (ptid.pid ());
 
   for (auto it = fork_list.begin (); it != fork_list.end (); ++it)
     if (it->ptid == ptid)
@@ -317,6 +319,8 @@ linux_fork_killall (void)
 	 aggravated by the first kill above - a child has just
 	 died.  MVS comment cut-and-pasted from linux-nat.  */
       } while (ret == pid && WIFSTOPPED (status));
+
+      linux_proc_mem_close (pid);
     }
 
   /* Clear list, prepare to start fresh.  */
@@ -30,6 +30,7 @@
 #include "linux-nat.h"
 #include "nat/linux-ptrace.h"
 #include "nat/linux-procfs.h"
+#include "nat/linux-proc-mem.h"
 #include "nat/linux-personality.h"
 #include "linux-fork.h"
 #include "gdbthread.h"
@@ -515,6 +516,10 @@ linux_nat_target::follow_fork (int follow_child, int detach_fork)
 		signo = 0;
 	      ptrace (PTRACE_DETACH, child_pid, 0, signo);
 	    }
+
+	  /* Detaching breakpoints from the child may have opened its
+	     /proc/PID/mem file.  */
+	  linux_proc_mem_close (child_pid);
 	}
       else
 	{
@@ -1486,6 +1491,8 @@ linux_nat_target::detach (inferior *inf, int from_tty)
   /* Only the initial process should be left right now.  */
   gdb_assert (num_lwps (pid) == 1);
 
+  linux_proc_mem_close (pid);
+
   main_lwp = find_lwp_pid (ptid_t (pid));
 
   if (forks_exist_p ())
@@ -3711,6 +3718,7 @@ kill_unfollowed_fork_children (struct inferior *inf)
 	  /* Let the arch-specific native code know this process is
 	     gone.  */
 	  linux_target->low_forget_process (child_pid);
+	  linux_proc_mem_close (child_pid);
 	}
     }
 }
@@ -3752,6 +3760,7 @@ linux_nat_target::mourn_inferior ()
   int pid = inferior_ptid.pid ();
 
   purge_lwp_list (pid);
+  linux_proc_mem_close (pid);
 
   if (! forks_exist_p ())
     /* Normal case, no other forks available.  */
@@ -3970,7 +3979,8 @@ linux_nat_target::pid_to_exec_file (int pid)
 
 /* Implement the to_xfer_partial target method using /proc/<pid>/mem.
    Because we can use a single read/write call, this can be much more
-   efficient than banging away at PTRACE_PEEKTEXT.  */
+   efficient than banging away at PTRACE_PEEKTEXT.  The file is kept
+   open per process, so this pays off even for a single word.  */
 
 static enum target_xfer_status
 linux_proc_xfer_partial (enum target_object object,
@@ -3979,40 +3989,12 @@ linux_proc_xfer_partial (enum target_object object,
 			 ULONGEST offset, LONGEST len, ULONGEST *xfered_len)
 {
   LONGEST ret;
-  int fd;
-  char filename[64];
 
   if (object != TARGET_OBJECT_MEMORY)
     return TARGET_XFER_EOF;
 
-  /* Don't bother for one word.  */
-  if (len < 3 * sizeof (long))
-    return TARGET_XFER_EOF;
-
-  /* We could keep this file open and cache it - possibly one per
-     thread.  That requires some juggling, but is even faster.  */
-  xsnprintf (filename, sizeof filename, "/proc/%ld/mem",
-	     inferior_ptid.lwp ());
-  fd = gdb_open_cloexec (filename, ((readbuf ? O_RDONLY : O_WRONLY)
-				    | O_LARGEFILE), 0);
-  if (fd == -1)
-    return TARGET_XFER_EOF;
-
-  /* Use pread64/pwrite64 if available, since they save a syscall and can
-     handle 64-bit offsets even on 32-bit platforms (for instance, SPARC
-     debugging a SPARC64 application).  */
-#ifdef HAVE_PREAD64
-  ret = (readbuf ? pread64 (fd, readbuf, len, offset)
-	 : pwrite64 (fd, writebuf, len, offset));
-#else
-  ret = lseek (fd, offset, SEEK_SET);
-  if (ret != -1)
-    ret = (readbuf ? read (fd, readbuf, len)
-	   : write (fd, writebuf, len));
-#endif
-
-  close (fd);
-
+  ret = linux_proc_mem_xfer (inferior_ptid.pid (), inferior_ptid.lwp (),
+			     readbuf, writebuf, offset, len);
   if (ret == -1 || ret == 0)
     return TARGET_XFER_EOF;
   else
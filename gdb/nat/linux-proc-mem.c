@@ -0,0 +1,159 @@
+/* Linux-specific access to inferior memory through /proc/PID/mem.
+   Copyright (C) 2019 Free Software Foundation, Inc.
+
+   This file is part of GDB.
+
+   This program is free software; you can redistribute it and/or modify
+   it under the terms of the GNU General Public License as published by
+   the Free Software Foundation; either version 3 of the License, or
+   (at your option) any later version.
+
+   This program is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+   GNU General Public License for more details.
+
+   You should have received a copy of the GNU General Public License
+   along with this program.  If not, see <http://www.gnu.org/licenses/>.  */
+
+#include "common/common-defs.h"
+#include "nat/linux-proc-mem.h"
+#include "common/filestuff.h"
+#include <fcntl.h>
+#include <sys/syscall.h>
+#include <sys/uio.h>
+#include <vector>
+
+/* An open /proc/PID/mem file.  */
+
+struct proc_mem_file
+{
+  /* The process whose memory the file gives access to.  */
+  pid_t pid;
+
+  /* The file descriptor.  */
+  int fd;
+};
+
+/* The files opened so far, one per process.  GDB rarely debugs more
+   than a handful of processes at once, so a linear search is
+   fine.  */
+
+static std::vector<proc_mem_file> proc_mem_files;
+
+/* Return the cached file of process PID, or NULL.  */
+
+static proc_mem_file *
+find_proc_mem_file (pid_t pid)
+{
+  for (proc_mem_file &file : proc_mem_files)
+    if (file.pid == pid)
+      return &file;
+  return NULL;
+}
+
+/* Open /proc/LWPID/mem, for writing too if we are allowed to.
+   Returns the file descriptor, or -1.  */
+
+static int
+open_proc_mem (pid_t lwpid)
+{
+  char filename[64];
+  int fd;
+
+  xsnprintf (filename, sizeof filename, "/proc/%ld/mem", (long) lwpid);
+  fd = gdb_open_cloexec (filename, O_RDWR | O_LARGEFILE, 0);
+  if (fd == -1)
+    fd = gdb_open_cloexec (filename, O_RDONLY | O_LARGEFILE, 0);
+  return fd;
+}
+
+/* Do a single read or write of LEN bytes at ADDR on FD.  */
+
+static LONGEST
+proc_mem_rw (int fd, gdb_byte *readbuf, const gdb_byte *writebuf,
+	     ULONGEST addr, ULONGEST len)
+{
+  /* Use pread64/pwrite64 if available, since they save a syscall and
+     can handle 64-bit offsets even on 32-bit platforms (for instance,
+     SPARC debugging a SPARC64 application).  */
+#ifdef HAVE_PREAD64
+  return (readbuf != NULL
+	  ? pread64 (fd, readbuf, len, addr)
+	  : pwrite64 (fd, writebuf, len, addr));
+#else
+  if (lseek (fd, addr, SEEK_SET) == -1)
+    return -1;
+  return (readbuf != NULL
+	  ? read (fd, readbuf, len)
+	  : write (fd, writebuf, len));
+#endif
+}
+
+/* See nat/linux-proc-mem.h.  */
+
+LONGEST
+linux_proc_mem_xfer (pid_t pid, pid_t lwpid, gdb_byte *readbuf,
+		     const gdb_byte *writebuf, ULONGEST addr, ULONGEST len)
+{
+  if (len == 0)
+    return 0;
+
+  for (int attempt = 0; attempt < 2; attempt++)
+    {
+      proc_mem_file *file = find_proc_mem_file (pid);
+
+      if (file == NULL)
+	{
+	  int fd = open_proc_mem (lwpid);
+
+	  if (fd == -1)
+	    break;
+	  proc_mem_files.push_back ({pid, fd});
+	  file = &proc_mem_files.back ();
+	}
+
+      LONGEST ret = proc_mem_rw (file->fd, readbuf, writebuf, addr, len);
+      if (ret > 0)
+	return ret;
+
+      /* An error means the range is not accessible, or the file was
+	 opened read-only.  */
+      if (ret == -1)
+	break;
+
+      /* A transfer of zero bytes means the address space the file
+	 was opened on is gone: the process exec'd, or it exited and
+	 PID was reused.  Open the file again.  */
+      linux_proc_mem_close (pid);
+    }
+
+#ifdef __NR_process_vm_readv
+  if (readbuf != NULL)
+    {
+      struct iovec local_iov = { readbuf, (size_t) len };
+      struct iovec remote_iov = { (void *) (uintptr_t) addr, (size_t) len };
+      LONGEST ret = syscall (__NR_process_vm_readv, lwpid,
+			     &local_iov, 1, &remote_iov, 1, 0);
+
+      if (ret > 0)
+	return ret;
+    }
+#endif
+
+  return -1;
+}
+
+/* See nat/linux-proc-mem.h.  */
+
+void
+linux_proc_mem_close (pid_t pid)
+{
+  for (auto it = proc_mem_files.begin (); it != proc_mem_files.end (); ++it)
+    if (it->pid == pid)
+      {
+	close (it->fd);
+	proc_mem_files.erase (it);
+	return;
+      }
+}
@@ -0,0 +1,46 @@
+/* Linux-specific access to inferior memory through /proc/PID/mem.
+   Copyright (C) 2019 Free Software Foundation, Inc.
+
+   This file is part of GDB.
+
+   This program is free software; you can redistribute it and/or modify
+   it under the terms of the GNU General Public License as published by
+   the Free Software Foundation; either version 3 of the License, or
+   (at your option) any later version.
+
+   This program is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+   GNU General Public License for more details.
+
+   You should have received a copy of the GNU General Public License
+   along with this program.  If not, see <http://www.gnu.org/licenses/>.  */
+
+#ifndef NAT_LINUX_PROC_MEM_H
+#define NAT_LINUX_PROC_MEM_H
+
+#include <unistd.h>
+
+/* Transfer LEN bytes at ADDR in the address space of process PID,
+   reading into READBUF or writing from WRITEBUF; exactly one of them
+   is non-NULL.  LWPID is a thread of PID, used to open the process's
+   /proc/LWPID/mem file the first time.  The file descriptor is then
+   kept open for PID, so that transfers of any size cost a single
+   system call.  If the file cannot be used, reads fall back to
+   process_vm_readv where available.
+
+   Returns the number of bytes transferred, which is less than LEN if
+   the range is only partially accessible, or -1 if nothing could be
+   transferred.  The caller should then fall back to ptrace.  */
+
+extern LONGEST linux_proc_mem_xfer (pid_t pid, pid_t lwpid,
+				    gdb_byte *readbuf,
+				    const gdb_byte *writebuf,
+				    ULONGEST addr, ULONGEST len);
+
+/* Close the cached /proc/PID/mem file descriptor of process PID, if
+   any.  Call this when PID is mourned or detached from.  */
+
+extern void linux_proc_mem_close (pid_t pid);
+
+#endif /* NAT_LINUX_PROC_MEM_H */
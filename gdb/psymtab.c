@@ -563,7 +563,7 @@ match_partial_symbol (struct objfile *objfile,
 	   &objfile->partial_symtabs->global_psymbols[pst->globals_offset] :
 	   &objfile->partial_symtabs->static_psymbols[pst->statics_offset]);
 
-  if (global && ordered_compare)  /* Can use a binary search.  */
+  if (ordered_compare)  /* Can use a binary search.  */
     {
       do_linear_search = 0;
 
@@ -657,10 +657,9 @@ lookup_partial_symbol (struct objfile *objfile,
 		       struct partial_symtab *pst, const char *name,
 		       int global, domain_enum domain)
 {
-  struct partial_symbol **start, **psym;
+  struct partial_symbol **start;
   struct partial_symbol **top, **real_top, **bottom, **center;
   int length = (global ? pst->n_global_syms : pst->n_static_syms);
-  int do_linear_search = 1;
 
   if (length == 0)
     return NULL;
@@ -673,68 +672,50 @@ lookup_partial_symbol (struct objfile *objfile,
 	   &objfile->partial_symtabs->global_psymbols[pst->globals_offset] :
 	   &objfile->partial_symtabs->static_psymbols[pst->statics_offset]);
 
-  if (global)			/* This means we can use a binary search.  */
+  /* Both the global and the static symbols of PST are sorted by
+     sort_pst_symbols, so we can use a binary search.  This search is
+     guaranteed to end with center pointing at the earliest partial
+     symbol whose name might be correct.  At that point *all* partial
+     symbols with an appropriate name will be checked against the
+     correct domain.  */
+
+  bottom = start;
+  top = start + length - 1;
+  real_top = top;
+  while (top > bottom)
     {
-      do_linear_search = 0;
-
-      /* Binary search.  This search is guaranteed to end with center
-         pointing at the earliest partial symbol whose name might be
-         correct.  At that point *all* partial symbols with an
-         appropriate name will be checked against the correct
-         domain.  */
-
-      bottom = start;
-      top = start + length - 1;
-      real_top = top;
-      while (top > bottom)
-	{
-	  center = bottom + (top - bottom) / 2;
-	  if (!(center < top))
-	    internal_error (__FILE__, __LINE__,
-			    _("failed internal consistency check"));
-	  if (strcmp_iw_ordered (symbol_search_name (*center),
-				 search_name.get ()) >= 0)
-	    {
-	      top = center;
-	    }
-	  else
-	    {
-	      bottom = center + 1;
-	    }
-	}
-      if (!(top == bottom))
+      center = bottom + (top - bottom) / 2;
+      if (!(center < top))
 	internal_error (__FILE__, __LINE__,
 			_("failed internal consistency check"));
-
-      /* For `case_sensitivity == case_sensitive_off' strcmp_iw_ordered will
-	 search more exactly than what matches SYMBOL_MATCHES_SEARCH_NAME.  */
-      while (top >= start && symbol_matches_search_name (*top, lookup_name))
-	top--;
-
-      /* Fixup to have a symbol which matches SYMBOL_MATCHES_SEARCH_NAME.  */
-      top++;
-
-      while (top <= real_top && symbol_matches_search_name (*top, lookup_name))
+      if (strcmp_iw_ordered (symbol_search_name (*center),
+			     search_name.get ()) >= 0)
 	{
-	  if (symbol_matches_domain ((*top)->language,
-				     (*top)->domain, domain))
-	    return *top;
-	  top++;
+	  top = center;
+	}
+      else
+	{
+	  bottom = center + 1;
 	}
     }
+  if (!(top == bottom))
+    internal_error (__FILE__, __LINE__,
+		    _("failed internal consistency check"));
 
-  /* Can't use a binary search or else we found during the binary search that
-     we should also do a linear search.  */
+  /* For `case_sensitivity == case_sensitive_off' strcmp_iw_ordered will
+     search more exactly than what matches SYMBOL_MATCHES_SEARCH_NAME.  */
+  while (top >= start && symbol_matches_search_name (*top, lookup_name))
+    top--;
 
-  if (do_linear_search)
+  /* Fixup to have a symbol which matches SYMBOL_MATCHES_SEARCH_NAME.  */
+  top++;
+
+  while (top <= real_top && symbol_matches_search_name (*top, lookup_name))
     {
-      for (psym = start; psym < start + length; psym++)
-	{
-	  if (symbol_matches_domain ((*psym)->language,
-				     (*psym)->domain, domain)
-	      && symbol_matches_search_name (*psym, lookup_name))
-	    return *psym;
-	}
+      if (symbol_matches_domain ((*top)->language,
+				 (*top)->domain, domain))
+	return *top;
+      top++;
     }
 
   return NULL;
@@ -1487,22 +1468,36 @@ const struct quick_symbol_functions psym_functions =
 
 
 
+/* Comparison function used to order the psymbols of a psymtab by
+   search name, so that they can be binary-searched.  */
+
+static bool
+psymbol_search_name_less (partial_symbol *s1, partial_symbol *s2)
+{
+  return strcmp_iw_ordered (symbol_search_name (s1),
+			    symbol_search_name (s2)) < 0;
+}
+
 static void
 sort_pst_symbols (struct objfile *objfile, struct partial_symtab *pst)
 {
-  /* Sort the global list; don't sort the static list.  */
+  /* The psymbols for this partial_symtab are currently at the end of
+     both vectors.  */
   auto begin = objfile->partial_symtabs->global_psymbols.begin ();
   std::advance (begin, pst->globals_offset);
-
-  /* The psymbols for this partial_symtab are currently at the end of the
-     vector.  */
   auto end = objfile->partial_symtabs->global_psymbols.end ();
 
-  std::sort (begin, end, [] (partial_symbol *s1, partial_symbol *s2)
-    {
-      return strcmp_iw_ordered (symbol_search_name (s1),
-				symbol_search_name (s2)) < 0;
-    });
+  std::sort (begin, end, psymbol_search_name_less);
+
+  /* Sort the static list too, so that lookups do not have to scan
+     every static symbol of the psymtab.  Use a stable sort so that,
+     among symbols sharing a name, the first one added is still the
+     first one found.  */
+  begin = objfile->partial_symtabs->static_psymbols.begin ();
+  std::advance (begin, pst->statics_offset);
+  end = objfile->partial_symtabs->static_psymbols.end ();
+
+  std::stable_sort (begin, end, psymbol_search_name_less);
 }
 
 /* Allocate and partially fill a partial symtab.  It will be
@@ -1546,22 +1541,29 @@ end_psymtab_common (struct objfile *objfile, struct partial_symtab *pst)
 static unsigned long
 psymbol_hash (const void *addr, int length)
 {
-  unsigned long h = 0;
   struct partial_symbol *psymbol = (struct partial_symbol *) addr;
-  unsigned int lang = psymbol->language;
-  unsigned int domain = psymbol->domain;
-  unsigned int theclass = psymbol->aclass;
-
-  h = hash_continue (&psymbol->value, sizeof (psymbol->value), h);
-  h = hash_continue (&lang, sizeof (unsigned int), h);
-  h = hash_continue (&domain, sizeof (unsigned int), h);
-  h = hash_continue (&theclass, sizeof (unsigned int), h);
-  /* Note that psymbol names are interned via symbol_set_names, so
-     there's no need to hash the contents of the name here.  */
-  h = hash_continue (&psymbol->name,
-		     sizeof (psymbol->name), h);
-
-  return h;
+
+  /* Gather the hashed fields into one key, so that they can be mixed
+     a word at a time in a single pass, rather than fed byte by byte
+     through hash_continue one field at a time.  Note that psymbol
+     names are interned via symbol_set_names, so there's no need to
+     hash the contents of the name here.  */
+  struct
+  {
+    const char *name;
+    CORE_ADDR address;
+    unsigned int bits;
+  } key;
+
+  /* Clear any padding, which is hashed too.  */
+  memset (&key, 0, sizeof (key));
+  key.name = psymbol->name;
+  key.address = psymbol->value.address;
+  key.bits = (psymbol->language
+	      | (psymbol->domain << LANGUAGE_BITS)
+	      | (psymbol->aclass << (LANGUAGE_BITS + SYMBOL_DOMAIN_BITS)));
+
+  return iterative_hash_object (key, 0);
 }
 
 /* Returns true if the symbol at addr1 equals the symbol at addr2.
@@ -99,6 +99,8 @@ public:
 					ULONGEST offset, ULONGEST len,
 					ULONGEST *xfered_len) override;
 
+  bool read_memory_ranges (gdb::array_view<memory_read_request> ranges) override;
+
   int insert_breakpoint (struct gdbarch *,
 			 struct bp_target_info *) override;
   int remove_breakpoint (struct gdbarch *, struct bp_target_info *,
@@ -1463,6 +1465,21 @@ record_btrace_target::xfer_partial (enum target_object object,
 					 offset, len, xfered_len);
 }
 
+/* The read_memory_ranges method of target record-btrace.  */
+
+bool
+record_btrace_target::read_memory_ranges
+  (gdb::array_view<memory_read_request> ranges)
+{
+  /* During replay, memory must be read through xfer_partial above.  */
+  if (replay_memory_access == replay_memory_access_read_only
+      && !record_btrace_generating_corefile
+      && record_is_replaying (inferior_ptid))
+    return false;
+
+  return this->beneath ()->read_memory_ranges (ranges);
+}
+
 /* The insert_breakpoint method of target record-btrace.  */
 
 int
@@ -53,20 +53,43 @@ static struct notif_client *notifs[] =
 gdb_static_assert (ARRAY_SIZE (notifs) == REMOTE_NOTIF_LAST);
 
 /* Parse the BUF for the expected notification NC, and send packet to
-   acknowledge.  */
+   acknowledge.  If BATCH, the stub batches events, and BUF may hold
+   several of them, separated by '|'; they are all acknowledged at
+   once.  Otherwise BUF holds a single event.  */
 
 void
 remote_notif_ack (remote_target *remote,
-		  struct notif_client *nc, const char *buf)
+		  struct notif_client *nc, const char *buf, bool batch)
 {
-  notif_event_up event = nc->alloc_event ();
+  std::vector<notif_event_up> events;
+  const char *p = buf;
+
+  while (1)
+    {
+      const char *sep = batch ? strchr (p, '|') : NULL;
+      notif_event_up event = nc->alloc_event ();
+
+      if (sep == NULL)
+	{
+	  nc->parse (remote, nc, p, event.get ());
+	  events.push_back (std::move (event));
+	  break;
+	}
+
+      std::string one (p, sep - p);
+
+      nc->parse (remote, nc, one.c_str (), event.get ());
+      events.push_back (std::move (event));
+      p = sep + 1;
+    }
 
   if (notif_debug)
-    fprintf_unfiltered (gdb_stdlog, "notif: ack '%s'\n",
-			nc->ack_command);
+    fprintf_unfiltered (gdb_stdlog, "notif: ack '%s' (%d events)\n",
+			nc->ack_command, (int) events.size ());
 
-  nc->parse (remote, nc, buf, event.get ());
-  nc->ack (remote, nc, buf, event.release ());
+  for (size_t i = 0; i + 1 < events.size (); i++)
+    nc->queue (remote, nc, events[i].release ());
+  nc->ack (remote, nc, buf, events.back ().release ());
 }
 
 /* Parse the BUF for the expected notification NC.  */
@@ -69,6 +69,14 @@ typedef struct notif_client
 	       struct notif_client *self, const char *buf,
 	       struct notif_event *event);
 
+  /* Queue EVENT, which came in a reply together with other events,
+     without acknowledging it.  Only the last event of such a reply is
+     passed to <ack>, which acknowledges all of them at once.  If
+     something is wrong, throw an exception.  */
+  void (*queue) (remote_target *remote,
+		 struct notif_client *self,
+		 struct notif_event *event);
+
   /* Check this notification client can get pending events in
      'remote_notif_process'.  */
   int (*can_get_pending_events) (remote_target *remote,
@@ -112,7 +120,7 @@ struct remote_notif_state
 };
 
 void remote_notif_ack (remote_target *remote, notif_client *nc,
-		       const char *buf);
+		       const char *buf, bool batch);
 struct notif_event *remote_notif_parse (remote_target *remote,
 					notif_client *nc,
 					const char *buf);
@@ -75,7 +75,9 @@
 #include "common/scoped_restore.h"
 #include "common/environ.h"
 #include "common/byte-vector.h"
+#include "common/scope-exit.h"
 #include <unordered_map>
+#include <zlib.h>
 
 /* The remote target.  */
 
@@ -86,6 +88,10 @@ Specify the serial device it is connected to\n\
 
 #define OPAQUETHREADBYTES 8
 
+/* With zlib transfers, how many times the packet size of data to ask
+   for in a single qXfer read or vFile:pread request.  */
+#define ZLIB_TRANSFER_FACTOR 16
+
 /* a 64 bit opaque identifier */
 typedef unsigned char threadref[OPAQUETHREADBYTES];
 
@@ -216,6 +222,18 @@ struct remote_arch_state
   long remote_packet_size;
 };
 
+/* A software breakpoint insertion or removal queued while a
+   breakpoint batch is open.  */
+
+struct queued_breakpoint_request
+{
+  /* The complete Z0 or z0 packet, as it would be sent on its own.  */
+  std::string packet;
+
+  /* The breakpoint the request is for.  */
+  bp_target_info *bp_tgt;
+};
+
 /* Description of the remote protocol state for the currently
    connected target.  This is per-target state, and independent of the
    selected architecture.  */
@@ -357,6 +375,22 @@ public: /* data */
      file descriptor at a time.  */
   struct readahead_cache readahead_cache;
 
+  /* True between begin_breakpoint_batch and commit_breakpoint_batch.
+     While set, software breakpoint insertions and removals are queued
+     in BREAKPOINT_BATCH instead of being sent one packet at a time.  */
+  bool breakpoint_batch_open = false;
+
+  /* The Z0/z0 requests queued for the next "vZ" packet, in order.  */
+  std::vector<queued_breakpoint_request> breakpoint_batch;
+
+  /* Total length of the requests in BREAKPOINT_BATCH, including their
+     separators.  */
+  size_t breakpoint_batch_size = 0;
+
+  /* The breakpoints whose queued request the stub rejected, to be
+     handed back by commit_breakpoint_batch.  */
+  std::vector<bp_target_info *> breakpoint_batch_failed;
+
   /* The list of already fetched and acknowledged stop events.  This
      queue is used for notification Stop, and other notifications
      don't need queue for their events, because the notification
@@ -428,6 +462,10 @@ public:
   int remove_breakpoint (struct gdbarch *, struct bp_target_info *,
 			 enum remove_bp_reason) override;
 
+  void begin_breakpoint_batch () override;
+
+  void commit_breakpoint_batch (std::vector<bp_target_info *> *failed) override;
+
 
   bool stopped_by_sw_breakpoint () override;
   bool supports_stopped_by_sw_breakpoint () override;
@@ -503,6 +541,8 @@ public:
 
   ULONGEST get_memory_xfer_limit () override;
 
+  bool read_memory_ranges (gdb::array_view<memory_read_request> ranges) override;
+
   void rcmd (const char *command, struct ui_file *output) override;
 
   char *pid_to_exec_file (int pid) override;
@@ -778,6 +818,9 @@ public: /* Remote specific methods.  */
   void set_continue_thread (ptid_t ptid);
   void set_general_process ();
 
+  bool queue_breakpoint_request (bp_target_info *bp_tgt);
+  void flush_breakpoint_batch ();
+
   char *write_ptid (char *buf, const char *endbuf, ptid_t ptid);
 
   int remote_unpack_thread_info_response (char *pkt, threadref *expectedref,
@@ -832,7 +875,7 @@ public: /* Remote specific methods.  */
   int fetch_register_using_p (struct regcache *regcache,
 			      packet_reg *reg);
   int send_g_packet ();
-  void process_g_packet (struct regcache *regcache);
+  void process_g_packet (struct regcache *regcache, const char *buf);
   void fetch_registers_using_g (struct regcache *regcache);
   int store_register_using_P (const struct regcache *regcache,
 			      packet_reg *reg);
@@ -2099,6 +2142,22 @@ enum {
   /* Support TARGET_WAITKIND_NO_RESUMED.  */
   PACKET_no_resumed,
 
+  /* Support for the vZ multi-breakpoint packet.  */
+  PACKET_vZ,
+
+  /* Support for the qMemRead multi-range memory read packet.  */
+  PACKET_qMemRead,
+
+  /* Support for zlib-compressed qXfer and vFile:pread replies.  */
+  PACKET_zlib_transfers,
+
+  /* Support for the registers of all stopped threads in all-stop stop
+     replies.  */
+  PACKET_expedite_all_registers,
+
+  /* Support for several stop replies in one reply to vStopped.  */
+  PACKET_vStopped_batch,
+
   PACKET_MAX
 };
 
@@ -2735,12 +2794,18 @@ remote_target::set_thread (ptid_t ptid, int gen)
 {
   struct remote_state *rs = get_remote_state ();
   ptid_t state = gen ? rs->general_thread : rs->continue_thread;
-  char *buf = rs->buf.data ();
-  char *endbuf = buf + get_remote_packet_size ();
 
   if (state == ptid)
     return;
 
+  /* Queued breakpoint requests apply to the general thread they were
+     made under.  */
+  if (gen)
+    flush_breakpoint_batch ();
+
+  char *buf = rs->buf.data ();
+  char *endbuf = buf + get_remote_packet_size ();
+
   *buf++ = 'H';
   *buf++ = gen ? 'g' : 'c';
   if (ptid == magic_null_ptid)
@@ -5186,6 +5251,13 @@ static const struct protocol_feature remote_protocol_features[] = {
   { "vContSupported", PACKET_DISABLE, remote_supported_packet, PACKET_vContSupported },
   { "QThreadEvents", PACKET_DISABLE, remote_supported_packet, PACKET_QThreadEvents },
   { "no-resumed", PACKET_DISABLE, remote_supported_packet, PACKET_no_resumed },
+  { "qMemRead", PACKET_DISABLE, remote_supported_packet, PACKET_qMemRead },
+  { "zlib-transfers", PACKET_DISABLE, remote_supported_packet,
+    PACKET_zlib_transfers },
+  { "expedite-all-registers", PACKET_DISABLE, remote_supported_packet,
+    PACKET_expedite_all_registers },
+  { "vStopped-batch", PACKET_DISABLE, remote_supported_packet,
+    PACKET_vStopped_batch },
 };
 
 static char *remote_support_xml;
@@ -5279,6 +5351,16 @@ remote_target::remote_query_supported ()
       if (packet_set_cmd_state (PACKET_no_resumed) != AUTO_BOOLEAN_FALSE)
 	remote_query_supported_append (&q, "no-resumed+");
 
+      if (packet_set_cmd_state (PACKET_zlib_transfers) != AUTO_BOOLEAN_FALSE)
+	remote_query_supported_append (&q, "zlib-transfers+");
+
+      if (packet_set_cmd_state (PACKET_expedite_all_registers)
+	  != AUTO_BOOLEAN_FALSE)
+	remote_query_supported_append (&q, "expedite-all-registers+");
+
+      if (packet_set_cmd_state (PACKET_vStopped_batch) != AUTO_BOOLEAN_FALSE)
+	remote_query_supported_append (&q, "vStopped-batch+");
+
       /* Keep this one last to work around a gdbserver <= 7.10 bug in
 	 the qSupported:xmlRegisters=i386 handling.  */
       if (remote_support_xml != NULL
@@ -6829,6 +6911,11 @@ struct stop_reply : public notif_event
      fetch them is avoided).  */
   std::vector<cached_reg_t> regcache;
 
+  /* Full register blocks of stopped threads, as sent in "regs" stop
+     reply fields, in 'g' packet format.  This saves a 'g' round trip
+     per thread when the stub supports expedite-all-registers.  */
+  std::vector<std::pair<ptid_t, std::string>> thread_registers;
+
   enum target_stop_reason stop_reason;
 
   CORE_ADDR watch_data_address;
@@ -6854,15 +6941,12 @@ remote_notif_stop_parse (remote_target *remote,
 }
 
 static void
-remote_notif_stop_ack (remote_target *remote,
-		       struct notif_client *self, const char *buf,
-		       struct notif_event *event)
+remote_notif_stop_queue (remote_target *remote,
+			 struct notif_client *self,
+			 struct notif_event *event)
 {
   struct stop_reply *stop_reply = (struct stop_reply *) event;
 
-  /* acknowledge */
-  putpkt (remote, self->ack_command);
-
   if (stop_reply->ws.kind == TARGET_WAITKIND_IGNORE)
     {
       /* We got an unknown stop reply.  */
@@ -6872,6 +6956,17 @@ remote_notif_stop_ack (remote_target *remote,
   remote->push_stop_reply (stop_reply);
 }
 
+static void
+remote_notif_stop_ack (remote_target *remote,
+		       struct notif_client *self, const char *buf,
+		       struct notif_event *event)
+{
+  /* acknowledge */
+  putpkt (remote, self->ack_command);
+
+  remote_notif_stop_queue (remote, self, event);
+}
+
 static int
 remote_notif_stop_can_get_pending_events (remote_target *remote,
 					  struct notif_client *self)
@@ -6906,6 +7001,7 @@ struct notif_client notif_client_stop =
   "vStopped",
   remote_notif_stop_parse,
   remote_notif_stop_ack,
+  remote_notif_stop_queue,
   remote_notif_stop_can_get_pending_events,
   remote_notif_stop_alloc_reply,
   REMOTE_NOTIF_STOP,
@@ -7183,6 +7279,7 @@ remote_target::remote_parse_stop_reply (const char *buf, stop_reply *event)
   event->ws.value.integer = 0;
   event->stop_reason = TARGET_STOPPED_BY_NO_REASON;
   event->regcache.clear ();
+  event->thread_registers.clear ();
   event->core = -1;
 
   switch (buf[0])
@@ -7334,6 +7431,20 @@ Packet: '%s'\n"),
 	      event->ws.kind = TARGET_WAITKIND_THREAD_CREATED;
 	      p = strchrnul (p1 + 1, ';');
 	    }
+	  else if (strprefix (p, p1, "regs"))
+	    {
+	      ptid_t thread_ptid = read_ptid (++p1, &p);
+
+	      if (*p != ',')
+		error (_("Malformed packet (missing comma after thread): %s\n\
+Packet: '%s'\n"),
+		       p, buf);
+	      p1 = p + 1;
+	      p = strchrnul (p1, ';');
+	      if (!skipregs)
+		event->thread_registers.emplace_back (thread_ptid,
+						      std::string (p1, p - p1));
+	    }
 	  else
 	    {
 	      ULONGEST pnum;
@@ -7589,7 +7700,9 @@ remote_target::remote_notif_get_pending_events (notif_client *nc)
 	  if (strcmp (rs->buf.data (), "OK") == 0)
 	    break;
 	  else
-	    remote_notif_ack (this, nc, rs->buf.data ());
+	    remote_notif_ack (this, nc, rs->buf.data (),
+			      (packet_support (PACKET_vStopped_batch)
+			       == PACKET_ENABLE));
 	}
     }
   else
@@ -7647,6 +7760,19 @@ remote_target::process_stop_reply (struct stop_reply *stop_reply,
 	  stop_reply->regcache.clear ();
 	}
 
+      /* Full register blocks of the stopped threads.  */
+      for (const auto &entry : stop_reply->thread_registers)
+	{
+	  if (find_thread_ptid (entry.first) == NULL)
+	    continue;
+
+	  inferior *inf = find_inferior_ptid (entry.first);
+	  struct regcache *regcache
+	    = get_thread_arch_regcache (entry.first, inf->gdbarch);
+	  process_g_packet (regcache, entry.second.c_str ());
+	}
+      stop_reply->thread_registers.clear ();
+
       remote_notice_new_inferior (ptid, 0);
       remote_thread_info *remote_thr = get_remote_thread_info (ptid);
       remote_thr->core = stop_reply->core;
@@ -7987,23 +8113,23 @@ remote_target::send_g_packet ()
 }
 
 void
-remote_target::process_g_packet (struct regcache *regcache)
+remote_target::process_g_packet (struct regcache *regcache, const char *buf)
 {
   struct gdbarch *gdbarch = regcache->arch ();
   struct remote_state *rs = get_remote_state ();
   remote_arch_state *rsa = rs->get_remote_arch_state (gdbarch);
   int i, buf_len;
-  char *p;
+  const char *p;
   char *regs;
 
-  buf_len = strlen (rs->buf.data ());
+  buf_len = strlen (buf);
 
   /* Further sanity checks, with knowledge of the architecture.  */
   if (buf_len > 2 * rsa->sizeof_g_packet)
     error (_("Remote 'g' packet reply is too long (expected %ld bytes, got %d "
 	     "bytes): %s"),
 	   rsa->sizeof_g_packet, buf_len / 2,
-	   rs->buf.data ());
+	   buf);
 
   /* Save the size of the packet sent to us by the target.  It is used
      as a heuristic when determining the max size of packets that the
@@ -8053,7 +8179,7 @@ remote_target::process_g_packet (struct regcache *regcache)
      hex characters.  Suck them all up, then supply them to the
      register cacheing/storage mechanism.  */
 
-  p = rs->buf.data ();
+  p = buf;
   for (i = 0; i < rsa->sizeof_g_packet; i++)
     {
       if (p[0] == 0 || p[1] == 0)
@@ -8075,13 +8201,13 @@ remote_target::process_g_packet (struct regcache *regcache)
 
       if (r->in_g_packet)
 	{
-	  if ((r->offset + reg_size) * 2 > strlen (rs->buf.data ()))
+	  if ((r->offset + reg_size) * 2 > strlen (buf))
 	    /* This shouldn't happen - we adjusted in_g_packet above.  */
 	    internal_error (__FILE__, __LINE__,
 			    _("unexpected end of 'g' packet reply"));
-	  else if (rs->buf[r->offset * 2] == 'x')
+	  else if (buf[r->offset * 2] == 'x')
 	    {
-	      gdb_assert (r->offset * 2 < strlen (rs->buf.data ()));
+	      gdb_assert (r->offset * 2 < strlen (buf));
 	      /* The register isn't available, mark it as such (at
 		 the same time setting the value to zero).  */
 	      regcache->raw_supply (r->regnum, NULL);
@@ -8096,7 +8222,7 @@ void
 remote_target::fetch_registers_using_g (struct regcache *regcache)
 {
   send_g_packet ();
-  process_g_packet (regcache);
+  process_g_packet (regcache, get_remote_state ()->buf.data ());
 }
 
 /* Make the remote selected traceframe match GDB's selected
@@ -8861,6 +8987,111 @@ remote_target::remote_read_bytes (CORE_ADDR memaddr,
   return remote_read_bytes_1 (memaddr, myaddr, len, unit_size, xfered_len);
 }
 
+/* Implementation of the read_memory_ranges target method, using the
+   "qMemRead" packet.  Each packet carries as many of RANGES as fit in
+   it and in its reply; a range too long for a single reply is cut
+   short, and the caller reads the rest on its own.  */
+
+bool
+remote_target::read_memory_ranges (gdb::array_view<memory_read_request> ranges)
+{
+  struct remote_state *rs = get_remote_state ();
+  int unit_size = gdbarch_addressable_memory_unit_size (target_gdbarch ());
+
+  /* Reading from a traceframe needs the checks done by
+     remote_read_bytes, one range at a time.  */
+  if (packet_support (PACKET_qMemRead) != PACKET_ENABLE
+      || !target_has_execution
+      || get_traceframe_number () != -1
+      || unit_size != 1)
+    return false;
+
+  set_remote_traceframe ();
+  set_general_thread (inferior_ptid);
+
+  long max_request = get_remote_packet_size ();
+  long max_reply = get_memory_read_packet_size ();
+  size_t next = 0;
+
+  while (next < ranges.size ())
+    {
+      std::string packet = "qMemRead:";
+      /* The index and requested length of each range sent.  */
+      std::vector<std::pair<size_t, ULONGEST>> sent;
+      long reply_size = 0;
+
+      for (; next < ranges.size (); next++)
+	{
+	  const memory_read_request &range = ranges[next];
+	  char entry[2 * (sizeof (ULONGEST) * 2) + 2];
+	  char *p = entry;
+
+	  /* An empty reply would look like an unsupported packet.  */
+	  if (range.len == 0)
+	    continue;
+
+	  /* Leave room in the reply for the separator, and for an error
+	     in place of the contents.  */
+	  long room = (max_reply - reply_size - 1) / 2;
+	  if (room < 2 || ((ULONGEST) room < range.len && !sent.empty ()))
+	    break;
+	  ULONGEST len = std::min (range.len, (ULONGEST) room);
+
+	  p += hexnumstr (p, (ULONGEST) remote_address_masked (range.addr));
+	  *p++ = ',';
+	  p += hexnumstr (p, len);
+	  *p = '\0';
+	  if (packet.size () + (p - entry) + 1 > (size_t) max_request)
+	    break;
+
+	  if (!sent.empty ())
+	    packet += ';';
+	  packet += entry;
+	  reply_size += std::max (2 * len, (ULONGEST) 3) + 1;
+	  sent.emplace_back (next, len);
+	}
+
+      if (sent.empty ())
+	continue;
+
+      putpkt (packet.c_str ());
+      getpkt (&rs->buf, 0);
+
+      switch (packet_ok (rs->buf, &remote_protocol_packets[PACKET_qMemRead]))
+	{
+	case PACKET_OK:
+	  {
+	    /* One result per range, separated by ';': the contents in
+	       hex, possibly fewer bytes than asked for, or "Enn".  The
+	       latter has an odd length, so it never decodes.  */
+	    const char *p = rs->buf.data ();
+
+	    for (const auto &range : sent)
+	      {
+		const char *end = strchrnul (p, ';');
+		size_t hex_len = end - p;
+
+		if (hex_len % 2 == 0)
+		  ranges[range.first].xfered_len
+		    = hex2bin (p, ranges[range.first].buf,
+			       std::min ((ULONGEST) hex_len / 2,
+					 range.second));
+
+		p = *end == ';' ? end + 1 : end;
+	      }
+	  }
+	  break;
+	case PACKET_ERROR:
+	  /* Nothing was read; the caller retries each range.  */
+	  break;
+	case PACKET_UNKNOWN:
+	  return false;
+	}
+    }
+
+  return true;
+}
+
 
 
 /* Sends a packet with content determined by the printf format string
@@ -10199,6 +10430,9 @@ remote_target::insert_breakpoint (struct gdbarch *gdbarch,
       if (can_run_breakpoint_commands ())
 	remote_add_target_side_commands (gdbarch, bp_tgt, p);
 
+      if (queue_breakpoint_request (bp_tgt))
+	return 0;
+
       putpkt (rs->buf);
       getpkt (&rs->buf, 0);
 
@@ -10248,6 +10482,9 @@ remote_target::remove_breakpoint (struct gdbarch *gdbarch,
       p += hexnumstr (p, addr);
       xsnprintf (p, endbuf - p, ",%d", bp_tgt->kind);
 
+      if (queue_breakpoint_request (bp_tgt))
+	return 0;
+
       putpkt (rs->buf);
       getpkt (&rs->buf, 0);
 
@@ -10257,6 +10494,158 @@ remote_target::remove_breakpoint (struct gdbarch *gdbarch,
   return memory_remove_breakpoint (this, gdbarch, bp_tgt, reason);
 }
 
+/* If a breakpoint batch is open and the stub is known to handle Z0
+   packets, queue the Z0 or z0 packet for BP_TGT that has just been
+   built in the remote state buffer, and return true.  Otherwise
+   return false, and the caller should send the packet itself.  */
+
+bool
+remote_target::queue_breakpoint_request (bp_target_info *bp_tgt)
+{
+  struct remote_state *rs = get_remote_state ();
+
+  if (!rs->breakpoint_batch_open
+      || packet_support (PACKET_Z0) != PACKET_ENABLE
+      || packet_support (PACKET_vZ) == PACKET_DISABLE)
+    return false;
+
+  std::string packet (rs->buf.data ());
+
+  /* Leave room for the "vZ;" prefix and the separator.  */
+  if (rs->breakpoint_batch_size + packet.size () + 4
+      > get_remote_packet_size ())
+    flush_breakpoint_batch ();
+
+  rs->breakpoint_batch_size += packet.size () + 1;
+  rs->breakpoint_batch.push_back ({std::move (packet), bp_tgt});
+  return true;
+}
+
+/* Send the breakpoint requests queued so far, recording the ones the
+   stub rejects in the remote state.  The requests go in a single "vZ"
+   packet when the stub supports it, and one packet each
+   otherwise.  */
+
+void
+remote_target::flush_breakpoint_batch ()
+{
+  struct remote_state *rs = get_remote_state ();
+
+  if (rs->breakpoint_batch.empty ())
+    return;
+
+  std::vector<queued_breakpoint_request> batch
+    = std::move (rs->breakpoint_batch);
+  rs->breakpoint_batch.clear ();
+  rs->breakpoint_batch_size = 0;
+
+  /* The number of requests the stub has answered.  */
+  size_t done = 0;
+
+  try
+    {
+      if (batch.size () > 1 && packet_support (PACKET_vZ) != PACKET_DISABLE)
+	{
+	  std::string packet = "vZ;";
+
+	  for (size_t i = 0; i < batch.size (); i++)
+	    {
+	      if (i > 0)
+		packet += '|';
+	      packet += batch[i].packet;
+	    }
+
+	  putpkt (packet.c_str ());
+	  getpkt (&rs->buf, 0);
+
+	  switch (packet_ok (rs->buf, &remote_protocol_packets[PACKET_vZ]))
+	    {
+	    case PACKET_OK:
+	      {
+		/* One "OK" or "Enn" per request, separated by ';'.  */
+		const char *p = rs->buf.data ();
+
+		for (const queued_breakpoint_request &req : batch)
+		  {
+		    if (!startswith (p, "OK")
+			|| (p[2] != ';' && p[2] != '\0'))
+		      rs->breakpoint_batch_failed.push_back (req.bp_tgt);
+
+		    p = strchrnul (p, ';');
+		    if (*p == ';')
+		      p++;
+		  }
+		return;
+	      }
+	    case PACKET_ERROR:
+	      for (const queued_breakpoint_request &req : batch)
+		rs->breakpoint_batch_failed.push_back (req.bp_tgt);
+	      return;
+	    case PACKET_UNKNOWN:
+	      /* The stub does not know "vZ"; packet_ok has disabled it,
+		 so send the requests one at a time below.  */
+	      break;
+	    }
+	}
+
+      for (; done < batch.size (); done++)
+	{
+	  const queued_breakpoint_request &req = batch[done];
+
+	  putpkt (req.packet.c_str ());
+	  getpkt (&rs->buf, 0);
+
+	  if (req.packet[0] == 'Z'
+	      ? packet_ok (rs->buf,
+			   &remote_protocol_packets[PACKET_Z0]) != PACKET_OK
+	      : rs->buf[0] == 'E')
+	    rs->breakpoint_batch_failed.push_back (req.bp_tgt);
+	}
+    }
+  catch (const gdb_exception &ex)
+    {
+      /* The stub never acknowledged the rest of the batch; report
+	 those requests as failed too before passing the error on.  */
+      for (; done < batch.size (); done++)
+	rs->breakpoint_batch_failed.push_back (batch[done].bp_tgt);
+      throw;
+    }
+}
+
+void
+remote_target::begin_breakpoint_batch ()
+{
+  struct remote_state *rs = get_remote_state ();
+
+  /* Batches do not nest, and commit_breakpoint_batch always sends
+     what was queued, so there is nothing to drop here.  */
+  gdb_assert (!rs->breakpoint_batch_open);
+  gdb_assert (rs->breakpoint_batch.empty ());
+  gdb_assert (rs->breakpoint_batch_failed.empty ());
+
+  rs->breakpoint_batch_open = true;
+}
+
+void
+remote_target::commit_breakpoint_batch (std::vector<bp_target_info *> *failed)
+{
+  struct remote_state *rs = get_remote_state ();
+
+  /* Close the batch first, so that an error while flushing does not
+     leave later requests queued.  */
+  rs->breakpoint_batch_open = false;
+
+  /* Hand back the failed requests even if flushing throws.  */
+  SCOPE_EXIT
+    {
+      failed->insert (failed->end (), rs->breakpoint_batch_failed.begin (),
+		      rs->breakpoint_batch_failed.end ());
+      rs->breakpoint_batch_failed.clear ();
+    };
+
+  flush_breakpoint_batch ();
+}
+
 static enum Z_packet_type
 watchpoint_to_Z_packet (int type)
 {
@@ -10776,8 +11165,13 @@ remote_target::remote_read_qxfer (const char *object_name,
   /* Request only enough to fit in a single packet.  The actual data
      may not, since we don't know how much of it will need to be escaped;
      the target is free to respond with slightly less data.  We subtract
-     five to account for the response type and the protocol frame.  */
-  n = std::min<LONGEST> (get_remote_packet_size () - 5, len);
+     five to account for the response type and the protocol frame.  With
+     zlib transfers, ask for more; the target sends it compressed if it
+     fits that way, and less of it otherwise.  */
+  n = get_remote_packet_size () - 5;
+  if (packet_support (PACKET_zlib_transfers) == PACKET_ENABLE)
+    n *= ZLIB_TRANSFER_FACTOR;
+  n = std::min<LONGEST> (n, len);
   snprintf (rs->buf.data (), get_remote_packet_size () - 4,
 	    "qXfer:%s:read:%s:%s,%s",
 	    object_name, annex ? annex : "",
@@ -10792,23 +11186,46 @@ remote_target::remote_read_qxfer (const char *object_name,
   if (packet_len < 0 || packet_ok (rs->buf, packet) != PACKET_OK)
     return TARGET_XFER_E_IO;
 
-  if (rs->buf[0] != 'l' && rs->buf[0] != 'm')
+  /* A 'z' prefix means the data is a zlib stream.  */
+  int data_start = rs->buf[0] == 'z' ? 2 : 1;
+  char type = rs->buf[data_start - 1];
+
+  if (type != 'l' && type != 'm')
     error (_("Unknown remote qXfer reply: %s"), rs->buf.data ());
 
   /* 'm' means there is (or at least might be) more data after this
      batch.  That does not make sense unless there's at least one byte
      of data in this reply.  */
-  if (rs->buf[0] == 'm' && packet_len == 1)
+  if (type == 'm' && packet_len == data_start)
     error (_("Remote qXfer reply contained no data."));
 
   /* Got some data.  */
-  i = remote_unescape_input ((gdb_byte *) rs->buf.data () + 1,
-			     packet_len - 1, readbuf, n);
+  if (data_start == 2)
+    {
+      gdb::byte_vector zdata (packet_len - data_start);
+      int zlen = remote_unescape_input ((gdb_byte *) rs->buf.data ()
+					+ data_start,
+					packet_len - data_start,
+					zdata.data (), zdata.size ());
+      uLongf inflated = n;
+
+      if (uncompress (readbuf, &inflated, zdata.data (), zlen) != Z_OK)
+	error (_("Could not decompress remote qXfer reply."));
+      i = inflated;
+
+      if (remote_debug)
+	fprintf_unfiltered (gdb_stdlog,
+			    "Inflated %d bytes of qXfer:%s data to %d\n",
+			    zlen, object_name, (int) i);
+    }
+  else
+    i = remote_unescape_input ((gdb_byte *) rs->buf.data () + 1,
+			       packet_len - 1, readbuf, n);
 
   /* 'l' is an EOF marker, possibly including a final block of data,
      or possibly empty.  If we have the final block of a non-empty
      object, record this fact to bypass a subsequent partial read.  */
-  if (rs->buf[0] == 'l' && offset + i > 0)
+  if (type == 'l' && offset + i > 0)
     {
       rs->finished_object = xstrdup (object_name);
       rs->finished_annex = xstrdup (annex ? annex : "");
@@ -11992,8 +12409,38 @@ remote_target::remote_hostio_pread_vFile (int fd, gdb_byte *read_buf, int len,
   if (ret < 0)
     return ret;
 
-  read_len = remote_unescape_input ((gdb_byte *) attachment, attachment_len,
-				    read_buf, len);
+  if (packet_support (PACKET_zlib_transfers) == PACKET_ENABLE)
+    {
+      /* With zlib transfers, an attachment shorter than the count the
+	 target reports is a zlib stream.  */
+      gdb::byte_vector data (attachment_len);
+
+      read_len = remote_unescape_input ((gdb_byte *) attachment,
+					attachment_len, data.data (),
+					attachment_len);
+      if (read_len < ret)
+	{
+	  uLongf inflated = len;
+
+	  if (uncompress (read_buf, &inflated, data.data (), read_len)
+	      != Z_OK)
+	    error (_("Could not decompress remote vFile:pread reply."));
+
+	  if (remote_debug)
+	    fprintf_unfiltered (gdb_stdlog,
+				"Inflated %d bytes of vFile:pread data to %d\n",
+				read_len, (int) inflated);
+	  read_len = inflated;
+	}
+      else
+	{
+	  read_len = std::min (read_len, len);
+	  memcpy (read_buf, data.data (), read_len);
+	}
+    }
+  else
+    read_len = remote_unescape_input ((gdb_byte *) attachment, attachment_len,
+				      read_buf, len);
   if (read_len != ret)
     error (_("Read returned %d, but %d bytes."), ret, (int) read_len);
 
@@ -12051,6 +12498,8 @@ remote_target::remote_hostio_pread (int fd, gdb_byte *read_buf, int len,
   cache->fd = fd;
   cache->offset = offset;
   cache->bufsize = get_remote_packet_size ();
+  if (packet_support (PACKET_zlib_transfers) == PACKET_ENABLE)
+    cache->bufsize *= ZLIB_TRANSFER_FACTOR;
   cache->buf = (gdb_byte *) xrealloc (cache->buf, cache->bufsize);
 
   ret = remote_hostio_pread_vFile (cache->fd, cache->buf, cache->bufsize,
@@ -14451,6 +14900,27 @@ Show the maximum size of the address (in bits) in a memory packet."), NULL,
   add_packet_config_cmd (&remote_protocol_packets[PACKET_Z0],
 			 "Z0", "software-breakpoint", 0);
 
+  add_packet_config_cmd (&remote_protocol_packets[PACKET_vZ],
+			 "vZ", "multi-breakpoint", 0);
+
+  add_packet_config_cmd (&remote_protocol_packets[PACKET_qMemRead],
+			 "qMemRead", "read-memory-ranges", 0);
+
+  add_packet_config_cmd (&remote_protocol_packets[PACKET_zlib_transfers],
+			 "zlib-transfers", "zlib-transfers", 0);
+
+  add_packet_config_cmd
+    (&remote_protocol_packets[PACKET_expedite_all_registers],
+     "expedite-all-registers", "expedite-all-registers", 0);
+  /* Off by default: the registers of every thread make each stop
+     reply much larger, which only pays off when GDB goes on to read
+     the registers of all threads.  */
+  remote_protocol_packets[PACKET_expedite_all_registers].detect
+    = AUTO_BOOLEAN_FALSE;
+
+  add_packet_config_cmd (&remote_protocol_packets[PACKET_vStopped_batch],
+			 "vStopped-batch", "vStopped-batch", 0);
+
   add_packet_config_cmd (&remote_protocol_packets[PACKET_Z1],
 			 "Z1", "hardware-breakpoint", 0);
 
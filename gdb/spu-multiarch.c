@@ -61,6 +61,8 @@ struct spu_multiarch_target final : public target_ops
 					ULONGEST offset, ULONGEST len,
 					ULONGEST *xfered_len) override;
 
+  bool read_memory_ranges (gdb::array_view<memory_read_request> ranges) override;
+
   int search_memory (CORE_ADDR start_addr, ULONGEST search_space_len,
 		     const gdb_byte *pattern, ULONGEST pattern_len,
 		     CORE_ADDR *found_addrp) override;
@@ -333,6 +335,20 @@ spu_multiarch_target::xfer_partial (enum target_object object,
 				    readbuf, writebuf, offset, len, xfered_len);
 }
 
+/* Override the read_memory_ranges routine.  */
+
+bool
+spu_multiarch_target::read_memory_ranges
+  (gdb::array_view<memory_read_request> ranges)
+{
+  /* SPU local store is only accessible through xfer_partial.  */
+  for (const memory_read_request &range : ranges)
+    if (SPUADDR_SPU (range.addr) >= 0)
+      return false;
+
+  return this->beneath ()->read_memory_ranges (ranges);
+}
+
 /* Override the to_search_memory routine.  */
 int
 spu_multiarch_target::search_memory (CORE_ADDR start_addr, ULONGEST search_space_len,
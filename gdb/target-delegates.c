@@ -22,6 +22,8 @@ struct dummy_target : public target_ops
   void files_info () override;
   int insert_breakpoint (struct gdbarch *arg0, struct bp_target_info *arg1) override;
   int remove_breakpoint (struct gdbarch *arg0, struct bp_target_info *arg1, enum remove_bp_reason arg2) override;
+  void begin_breakpoint_batch () override;
+  void commit_breakpoint_batch (std::vector<bp_target_info *> *arg0) override;
   bool stopped_by_sw_breakpoint () override;
   bool supports_stopped_by_sw_breakpoint () override;
   bool stopped_by_hw_breakpoint () override;
@@ -92,6 +94,7 @@ struct dummy_target : public target_ops
   void goto_bookmark (const gdb_byte *arg0, int arg1) override;
   CORE_ADDR get_thread_local_address (ptid_t arg0, CORE_ADDR arg1, CORE_ADDR arg2) override;
   enum target_xfer_status xfer_partial (enum target_object arg0, const char *arg1, gdb_byte *arg2, const gdb_byte *arg3, ULONGEST arg4, ULONGEST arg5, ULONGEST *arg6) override;
+  bool read_memory_ranges (gdb::array_view<memory_read_request> arg0) override;
   ULONGEST get_memory_xfer_limit () override;
   std::vector<mem_region> memory_map () override;
   void flash_erase (ULONGEST arg0, LONGEST arg1) override;
@@ -190,6 +193,8 @@ struct debug_target : public target_ops
   void files_info () override;
   int insert_breakpoint (struct gdbarch *arg0, struct bp_target_info *arg1) override;
   int remove_breakpoint (struct gdbarch *arg0, struct bp_target_info *arg1, enum remove_bp_reason arg2) override;
+  void begin_breakpoint_batch () override;
+  void commit_breakpoint_batch (std::vector<bp_target_info *> *arg0) override;
   bool stopped_by_sw_breakpoint () override;
   bool supports_stopped_by_sw_breakpoint () override;
   bool stopped_by_hw_breakpoint () override;
@@ -260,6 +265,7 @@ struct debug_target : public target_ops
   void goto_bookmark (const gdb_byte *arg0, int arg1) override;
   CORE_ADDR get_thread_local_address (ptid_t arg0, CORE_ADDR arg1, CORE_ADDR arg2) override;
   enum target_xfer_status xfer_partial (enum target_object arg0, const char *arg1, gdb_byte *arg2, const gdb_byte *arg3, ULONGEST arg4, ULONGEST arg5, ULONGEST *arg6) override;
+  bool read_memory_ranges (gdb::array_view<memory_read_request> arg0) override;
   ULONGEST get_memory_xfer_limit () override;
   std::vector<mem_region> memory_map () override;
   void flash_erase (ULONGEST arg0, LONGEST arg1) override;
@@ -631,6 +637,47 @@ debug_target::remove_breakpoint (struct gdbarch *arg0, struct bp_target_info *ar
   return result;
 }
 
+void
+target_ops::begin_breakpoint_batch ()
+{
+  this->beneath ()->begin_breakpoint_batch ();
+}
+
+void
+dummy_target::begin_breakpoint_batch ()
+{
+}
+
+void
+debug_target::begin_breakpoint_batch ()
+{
+  fprintf_unfiltered (gdb_stdlog, "-> %s->begin_breakpoint_batch (...)\n", this->beneath ()->shortname ());
+  this->beneath ()->begin_breakpoint_batch ();
+  fprintf_unfiltered (gdb_stdlog, "<- %s->begin_breakpoint_batch (", this->beneath ()->shortname ());
+  fputs_unfiltered (")\n", gdb_stdlog);
+}
+
+void
+target_ops::commit_breakpoint_batch (std::vector<bp_target_info *> *arg0)
+{
+  this->beneath ()->commit_breakpoint_batch (arg0);
+}
+
+void
+dummy_target::commit_breakpoint_batch (std::vector<bp_target_info *> *arg0)
+{
+}
+
+void
+debug_target::commit_breakpoint_batch (std::vector<bp_target_info *> *arg0)
+{
+  fprintf_unfiltered (gdb_stdlog, "-> %s->commit_breakpoint_batch (...)\n", this->beneath ()->shortname ());
+  this->beneath ()->commit_breakpoint_batch (arg0);
+  fprintf_unfiltered (gdb_stdlog, "<- %s->commit_breakpoint_batch (", this->beneath ()->shortname ());
+  target_debug_print_std_vector_bp_target_info_p_p (arg0);
+  fputs_unfiltered (")\n", gdb_stdlog);
+}
+
 bool
 target_ops::stopped_by_sw_breakpoint ()
 {
@@ -2409,6 +2456,32 @@ debug_target::xfer_partial (enum target_object arg0, const char *arg1, gdb_byte
   return result;
 }
 
+bool
+target_ops::read_memory_ranges (gdb::array_view<memory_read_request> arg0)
+{
+  return this->beneath ()->read_memory_ranges (arg0);
+}
+
+bool
+dummy_target::read_memory_ranges (gdb::array_view<memory_read_request> arg0)
+{
+  return false;
+}
+
+bool
+debug_target::read_memory_ranges (gdb::array_view<memory_read_request> arg0)
+{
+  bool result;
+  fprintf_unfiltered (gdb_stdlog, "-> %s->read_memory_ranges (...)\n", this->beneath ()->shortname ());
+  result = this->beneath ()->read_memory_ranges (arg0);
+  fprintf_unfiltered (gdb_stdlog, "<- %s->read_memory_ranges (", this->beneath ()->shortname ());
+  target_debug_print_gdb_array_view_memory_read_request (arg0);
+  fputs_unfiltered (") = ", gdb_stdlog);
+  target_debug_print_bool (result);
+  fputs_unfiltered ("\n", gdb_stdlog);
+  return result;
+}
+
 ULONGEST
 target_ops::get_memory_xfer_limit ()
 {
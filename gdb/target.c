@@ -1304,6 +1304,17 @@ target_read_raw_memory (CORE_ADDR memaddr, gdb_byte *myaddr, ssize_t len)
     return -1;
 }
 
+/* See target.h.  */
+
+bool
+target_read_raw_memory_ranges (gdb::array_view<memory_read_request> ranges)
+{
+  for (memory_read_request &range : ranges)
+    range.xfered_len = 0;
+
+  return current_top_target ()->read_memory_ranges (ranges);
+}
+
 /* Like target_read_memory, but specify explicitly that this is a read from
    the target's stack.  This may trigger different cache behavior.  */
 
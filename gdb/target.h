@@ -298,6 +298,22 @@ struct memory_read_result
 extern std::vector<memory_read_result> read_memory_robust
     (struct target_ops *ops, const ULONGEST offset, const LONGEST len);
 
+/* One range of memory to read with target_read_memory_ranges.  */
+
+struct memory_read_request
+{
+  /* The address and length of the range.  */
+  CORE_ADDR addr;
+  ULONGEST len;
+
+  /* Where to store the contents; LEN units long.  */
+  gdb_byte *buf;
+
+  /* Set by the target to the number of units read from the start of
+     the range.  */
+  ULONGEST xfered_len;
+};
+
 /* Request that OPS transfer up to LEN addressable units from BUF to the
    target's OBJECT.  When writing to a memory object, the addressable unit
    size is architecture dependent and can be found using
@@ -501,6 +517,23 @@ struct target_ops
 				 enum remove_bp_reason)
       TARGET_DEFAULT_NORETURN (noprocess ());
 
+    /* Start queueing software breakpoint insertions and removals, so
+       that a target with a round-trip cost per request can send them
+       all at once in commit_breakpoint_batch.  While a batch is open,
+       insert_breakpoint and remove_breakpoint may return success for
+       a request that has only been queued.  Batches do not nest.  */
+    virtual void begin_breakpoint_batch ()
+      TARGET_DEFAULT_IGNORE ();
+
+    /* Send the requests queued since begin_breakpoint_batch and close
+       the batch.  Appends to FAILED the breakpoints whose queued
+       request failed on the target; the caller should retry those
+       individually to report the error.  If sending the requests
+       throws, FAILED also holds every request the target did not
+       acknowledge before the error.  */
+    virtual void commit_breakpoint_batch (std::vector<bp_target_info *> *failed)
+      TARGET_DEFAULT_IGNORE ();
+
     /* Returns true if the target stopped because it executed a
        software breakpoint.  This is necessary for correct background
        execution / non-stop mode operation, and for correct PC
@@ -770,6 +803,16 @@ struct target_ops
 						  ULONGEST *xfered_len)
       TARGET_DEFAULT_RETURN (TARGET_XFER_E_IO);
 
+    /* Read several ranges of raw memory in one request, for targets
+       where each request has a round-trip cost.  Set the XFERED_LEN
+       of each element of RANGES to the number of addressable units
+       read from the start of that range, 0 if none.  Return false if
+       the target cannot do this; the caller should then read the
+       ranges one at a time.  */
+
+    virtual bool read_memory_ranges (gdb::array_view<memory_read_request> ranges)
+      TARGET_DEFAULT_RETURN (false);
+
     /* Return the limit on the size of any single memory transfer
        for the target.  */
 
@@ -1482,6 +1525,13 @@ extern int target_read_string (CORE_ADDR, gdb::unique_xmalloc_ptr<char> *,
 extern int target_read_raw_memory (CORE_ADDR memaddr, gdb_byte *myaddr,
 				   ssize_t len);
 
+/* Read each of RANGES from the target's raw memory, in a single
+   request if the target stack supports it.  Return false if it does
+   not; the caller should then read the ranges one at a time.  */
+
+extern bool target_read_raw_memory_ranges
+  (gdb::array_view<memory_read_request> ranges);
+
 extern int target_read_stack (CORE_ADDR memaddr, gdb_byte *myaddr, ssize_t len);
 
 extern int target_read_code (CORE_ADDR memaddr, gdb_byte *myaddr, ssize_t len);
@@ -1572,6 +1622,18 @@ extern int target_remove_breakpoint (struct gdbarch *gdbarch,
 				     struct bp_target_info *bp_tgt,
 				     enum remove_bp_reason reason);
 
+/* Start batching software breakpoint insertions and removals.  See
+   target_ops::begin_breakpoint_batch.  */
+
+#define target_begin_breakpoint_batch()				\
+     (current_top_target ()->begin_breakpoint_batch) ()
+
+/* Flush the current breakpoint batch, appending the breakpoints whose
+   queued request failed to FAILED.  */
+
+#define target_commit_breakpoint_batch(failed)			\
+     (current_top_target ()->commit_breakpoint_batch) (failed)
+
 /* Return true if the target stack has a non-default
   "terminal_ours" method.  */
 
@@ -0,0 +1,64 @@
+/* This testcase is part of GDB, the GNU debugger.
+
+   Copyright 2019 Free Software Foundation, Inc.
+
+   This program is free software; you can redistribute it and/or modify
+   it under the terms of the GNU General Public License as published by
+   the Free Software Foundation; either version 3 of the License, or
+   (at your option) any later version.
+
+   This program is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+   GNU General Public License for more details.
+
+   You should have received a copy of the GNU General Public License
+   along with this program.  If not, see <http://www.gnu.org/licenses/>.  */
+
+
+struct point
+{
+  int x;
+  short y;
+  signed char c;
+  unsigned int bits : 3;
+};
+
+struct point points[100];
+volatile int counter;
+double ratio;
+int *null_ptr;
+
+int
+square (int v)
+{
+  return v * v;
+}
+
+static void
+visit (struct point *p, int i)
+{
+  counter += p->x;	/* visit-line */
+}
+
+int
+main (void)
+{
+  int i;
+
+  for (i = 0; i < 100; i++)
+    {
+      points[i].x = i;
+      points[i].y = -i;
+      points[i].c = (signed char) (i * 3);
+      points[i].bits = i;
+    }
+
+  for (i = 0; i < 100; i++)
+    {
+      ratio = i / 2.0;
+      visit (&points[i], i);
+    }
+
+  return 0;
+}
@@ -0,0 +1,52 @@
+/* Copyright 2019 Free Software Foundation, Inc.
+
+   This file is part of GDB.
+
+   This program is free software; you can redistribute it and/or modify
+   it under the terms of the GNU General Public License as published by
+   the Free Software Foundation; either version 3 of the License, or
+   (at your option) any later version.
+
+   This program is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+   GNU General Public License for more details.
+
+   You should have received a copy of the GNU General Public License
+   along with this program.  If not, see <http://www.gnu.org/licenses/>.  */
+
+#include <string.h>
+#include <sys/mman.h>
+#include <unistd.h>
+
+#define NPAGES 3
+
+unsigned char *buf;
+long pagesize;
+
+static void
+break_here (void)
+{
+}
+
+int
+main (void)
+{
+  int i;
+
+  pagesize = sysconf (_SC_PAGESIZE);
+  buf = mmap (NULL, NPAGES * pagesize, PROT_READ | PROT_WRITE,
+	      MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+  if (buf == MAP_FAILED)
+    return 1;
+
+  for (i = 0; i < NPAGES; i++)
+    memset (buf + i * pagesize, 0x11 * (i + 1), pagesize);
+
+  /* Split the mapping in three, so that the core file holds a
+     separate segment for each page.  */
+  mprotect (buf + pagesize, pagesize, PROT_READ);
+
+  break_here ();
+  return 0;
+}
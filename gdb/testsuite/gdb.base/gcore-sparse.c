@@ -0,0 +1,45 @@
+/* Copyright 2019 Free Software Foundation, Inc.
+
+   This file is part of GDB.
+
+   This program is free software; you can redistribute it and/or modify
+   it under the terms of the GNU General Public License as published by
+   the Free Software Foundation; either version 3 of the License, or
+   (at your option) any later version.
+
+   This program is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+   GNU General Public License for more details.
+
+   You should have received a copy of the GNU General Public License
+   along with this program.  If not, see <http://www.gnu.org/licenses/>.  */
+
+#include <stdlib.h>
+#include <string.h>
+
+#define BLOCK 4096
+#define NBLOCKS 16
+
+char *buffer;
+
+static void
+break_here (void)
+{
+}
+
+int
+main (void)
+{
+  int i;
+
+  /* Interleave all-zero and non-zero blocks, and leave the final
+     block zero so the section ends in a hole.  */
+  buffer = malloc (BLOCK * NBLOCKS);
+  memset (buffer, 0, BLOCK * NBLOCKS);
+  for (i = 0; i < NBLOCKS - 1; i += 2)
+    memset (buffer + i * BLOCK, i + 1, BLOCK);
+
+  break_here ();
+  return 0;
+}
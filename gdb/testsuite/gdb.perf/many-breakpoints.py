@@ -0,0 +1,43 @@
+# Copyright (C) 2019 Free Software Foundation, Inc.
+
+# This program is free software; you can redistribute it and/or modify
+# it under the terms of the GNU General Public License as published by
+# the Free Software Foundation; either version 3 of the License, or
+# (at your option) any later version.
+#
+# This program is distributed in the hope that it will be useful,
+# but WITHOUT ANY WARRANTY; without even the implied warranty of
+# MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+# GNU General Public License for more details.
+#
+# You should have received a copy of the GNU General Public License
+# along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+# This test case is to test the speed of GDB when it creates and
+# deletes many breakpoints, each of which updates the global list of
+# breakpoint locations.
+
+from perftest import perftest
+
+class ManyBreakpoints(perftest.TestCaseWithBasicMeasurements):
+    def __init__(self, count):
+        super(ManyBreakpoints, self).__init__("many-breakpoints")
+        self.count = count
+        self.base = int(gdb.parse_and_eval("(long) &main"))
+
+    def _test(self, count):
+        # Internal breakpoints are not announced, which keeps the
+        # output small.  The breakpoints are not inserted, so their
+        # addresses need not be instruction boundaries.
+        bps = [gdb.Breakpoint("*%d" % (self.base + i), internal=True)
+               for i in range(count)]
+        for bp in bps:
+            bp.delete()
+
+    def warm_up(self):
+        self._test(self.count)
+
+    def execute_test(self):
+        for i in range(1, 5):
+            func = lambda: self._test(i * self.count)
+            self.measure.measure(func, i * self.count)
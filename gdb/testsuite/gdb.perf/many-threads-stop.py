@@ -0,0 +1,38 @@
+# Copyright (C) 2019 Free Software Foundation, Inc.
+
+# This program is free software; you can redistribute it and/or modify
+# it under the terms of the GNU General Public License as published by
+# the Free Software Foundation; either version 3 of the License, or
+# (at your option) any later version.
+#
+# This program is distributed in the hope that it will be useful,
+# but WITHOUT ANY WARRANTY; without even the implied warranty of
+# MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+# GNU General Public License for more details.
+#
+# You should have received a copy of the GNU General Public License
+# along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+# This test case is to test the speed of GDB when a process with many
+# threads stops and is resumed repeatedly.  Each stop and resume of
+# all threads maps every thread's event and state change back to its
+# thread_info by ptid.
+
+from perftest import perftest
+
+class ManyThreadsStop(perftest.TestCaseWithBasicMeasurements):
+    def __init__(self, count):
+        super(ManyThreadsStop, self).__init__("many-threads-stop")
+        self.count = count
+
+    def _run(self, count):
+        for _ in range(0, count):
+            gdb.execute("continue", False, True)
+
+    def warm_up(self):
+        self._run(1)
+
+    def execute_test(self):
+        for i in range(1, 5):
+            func = lambda: self._run(i * self.count)
+            self.measure.measure(func, i * self.count)
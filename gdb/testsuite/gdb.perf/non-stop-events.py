@@ -0,0 +1,68 @@
+# Copyright (C) 2019 Free Software Foundation, Inc.
+
+# This program is free software; you can redistribute it and/or modify
+# it under the terms of the GNU General Public License as published by
+# the Free Software Foundation; either version 3 of the License, or
+# (at your option) any later version.
+#
+# This program is distributed in the hope that it will be useful,
+# but WITHOUT ANY WARRANTY; without even the implied warranty of
+# MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+# GNU General Public License for more details.
+#
+# You should have received a copy of the GNU General Public License
+# along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+# This test case is to test how many stop events GDB handles per
+# second in non-stop mode, when many threads hit a breakpoint whose
+# condition is false at about the same time.
+
+import time
+
+from perftest import perftest
+from perftest import measure
+from perftest import testresult
+
+class MeasurementEventRate(measure.Measurement):
+    """Measurement on the number of stop events handled per second.
+
+    The id of each measurement is the number of events."""
+
+    def __init__(self, result):
+        super(MeasurementEventRate, self).__init__("events_per_second",
+                                                   result)
+        self.start_time = 0
+
+    def start(self, id):
+        self.start_time = time.time()
+
+    def stop(self, id):
+        wall_time = time.time() - self.start_time
+        self.result.record(id, id / wall_time if wall_time > 0 else 0)
+
+class NonStopEvents(perftest.TestCase):
+    def __init__(self, threads, iterations):
+        result_factory = testresult.SingleStatisticResultFactory()
+        measurements = [
+            measure.MeasurementWallTime(result_factory.create_result()),
+            MeasurementEventRate(result_factory.create_result())]
+        super(NonStopEvents, self).__init__("non-stop-events",
+                                            measure.Measure(measurements))
+        self.threads = threads
+        self.iterations = iterations
+
+    def _run(self, iterations):
+        gdb.execute("set variable iterations = %d" % iterations)
+        # Each thread hits the breakpoint on event_here ITERATIONS
+        # times, and GDB resumes it each time.  The round ends when
+        # main reaches round_done.
+        gdb.execute("continue", False, True)
+
+    def warm_up(self):
+        self._run(1)
+
+    def execute_test(self):
+        for i in range(1, 5):
+            iterations = i * self.iterations
+            func = lambda: self._run(iterations)
+            self.measure.measure(func, iterations * self.threads)
@@ -0,0 +1,77 @@
+/* This testcase is part of GDB, the GNU debugger.
+
+   Copyright (C) 2019 Free Software Foundation, Inc.
+
+   This program is free software; you can redistribute it and/or modify
+   it under the terms of the GNU General Public License as published by
+   the Free Software Foundation; either version 3 of the License, or
+   (at your option) any later version.
+
+   This program is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+   GNU General Public License for more details.
+
+   You should have received a copy of the GNU General Public License
+   along with this program.  If not, see <http://www.gnu.org/licenses/>.  */
+
+#include <pthread.h>
+#include <unistd.h>
+
+#ifndef NUM_THREADS
+#define NUM_THREADS 1000
+#endif
+
+#ifndef STACK_DEPTH
+#define STACK_DEPTH 20
+#endif
+
+volatile int ready;
+
+void
+stop_here (void)
+{
+}
+
+static void __attribute__ ((noinline))
+recurse (int depth)
+{
+  if (depth > 0)
+    recurse (depth - 1);
+  else
+    {
+      __sync_fetch_and_add (&ready, 1);
+      while (1)
+	pause ();
+    }
+}
+
+static void *
+thread_function (void *arg)
+{
+  /* Block at the same PCs as every other thread, under a stack of
+     STACK_DEPTH frames.  */
+  recurse (STACK_DEPTH);
+  return NULL;
+}
+
+int
+main (void)
+{
+  pthread_t thread;
+  pthread_attr_t attr;
+  int i;
+
+  /* Keep the address space small with many threads.  */
+  pthread_attr_init (&attr);
+  pthread_attr_setstacksize (&attr, 64 * 1024);
+
+  for (i = 0; i < NUM_THREADS; i++)
+    pthread_create (&thread, &attr, thread_function, NULL);
+
+  while (ready < NUM_THREADS)
+    usleep (1000);
+
+  stop_here ();
+  return 0;
+}
@@ -234,9 +234,52 @@ init_thread_list (void)
 	set_thread_exited (tp, 1);
 
       inf->thread_list = NULL;
+      inf->thread_list_tail = NULL;
+      inf->ptid_thread_map.clear ();
     }
 }
 
+/* Make TP's entry in its inferior's ptid_thread_map, which is about
+   to go away (TP is removed from the list, or its ptid changes), point
+   to the next thread in the list with the same ptid, if any.  */
+
+static void
+ptid_thread_map_remove (thread_info *tp)
+{
+  std::unordered_map<ptid_t, thread_info *, hash_ptid> &map
+    = tp->inf->ptid_thread_map;
+  auto it = map.find (tp->ptid);
+
+  if (it == map.end () || it->second != tp)
+    return;
+
+  /* TP was the first thread with this ptid, so any other one comes
+     after it.  */
+  for (thread_info *other = tp->next; other != NULL; other = other->next)
+    if (other->ptid == tp->ptid)
+      {
+	it->second = other;
+	return;
+      }
+
+  map.erase (it);
+}
+
+/* Add TP, whose ptid just changed, to its inferior's ptid_thread_map,
+   unless a thread earlier in the list has the same ptid.  */
+
+static void
+ptid_thread_map_add (thread_info *tp)
+{
+  for (thread_info *other = tp->inf->thread_list;
+       other != tp;
+       other = other->next)
+    if (other->ptid == tp->ptid)
+      return;
+
+  tp->inf->ptid_thread_map[tp->ptid] = tp;
+}
+
 /* Allocate a new thread of inferior INF with target id PTID and add
    it to the thread list.  */
 
@@ -248,13 +291,12 @@ new_thread (struct inferior *inf, ptid_t ptid)
   if (inf->thread_list == NULL)
     inf->thread_list = tp;
   else
-    {
-      struct thread_info *last;
+    inf->thread_list_tail->next = tp;
+  inf->thread_list_tail = tp;
 
-      for (last = inf->thread_list; last->next != NULL; last = last->next)
-	;
-      last->next = tp;
-    }
+  /* New threads go last, so an existing thread with the same ptid
+     keeps its entry.  */
+  inf->ptid_thread_map.emplace (ptid, tp);
 
   return tp;
 }
@@ -291,7 +333,9 @@ add_thread_silent (ptid_t ptid)
 	  delete_thread (tp);
 
 	  /* Now reset its ptid, and reswitch inferior_ptid to it.  */
+	  ptid_thread_map_remove (new_thr);
 	  new_thr->ptid = ptid;
+	  ptid_thread_map_add (new_thr);
 	  new_thr->state = THREAD_STOPPED;
 	  switch_to_thread (new_thr);
 
@@ -469,10 +513,14 @@ delete_thread_1 (thread_info *thr, bool silent)
        return;
      }
 
+  ptid_thread_map_remove (tp);
+
   if (tpprev)
     tpprev->next = tp->next;
   else
     tp->inf->thread_list = tp->next;
+  if (tp->inf->thread_list_tail == tp)
+    tp->inf->thread_list_tail = tpprev;
 
   delete tp;
 }
@@ -530,11 +578,12 @@ find_thread_ptid (ptid_t ptid)
 struct thread_info *
 find_thread_ptid (inferior *inf, ptid_t ptid)
 {
-  for (thread_info *tp : inf->threads ())
-    if (tp->ptid == ptid)
-      return tp;
+  auto it = inf->ptid_thread_map.find (ptid);
 
-  return NULL;
+  if (it == inf->ptid_thread_map.end ())
+    return NULL;
+
+  return it->second;
 }
 
 /* See gdbthread.h.  */
@@ -770,7 +819,9 @@ thread_change_ptid (ptid_t old_ptid, ptid_t new_ptid)
   inf->pid = new_ptid.pid ();
 
   tp = find_thread_ptid (inf, old_ptid);
+  ptid_thread_map_remove (tp);
   tp->ptid = new_ptid;
+  ptid_thread_map_add (tp);
 
   gdb::observers::thread_ptid_changed.notify (old_ptid, new_ptid);
 }